@@ -0,0 +1,47 @@
+#ifndef MYSTL_BENCH_H
+#define MYSTL_BENCH_H
+
+//Helpers shared by the benchmark programs in this directory.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+namespace bench {
+
+    //Seconds since an arbitrary start, from the steady clock.
+    inline double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //Small fast generator, good enough to spread keys and deadlines.
+    class xorshift {
+    public:
+        explicit xorshift(uint64_t seed = 88172645463325252ull): _s(seed ? seed : 1) {}
+        uint64_t operator()() {
+            _s ^= _s << 13;
+            _s ^= _s >> 7;
+            _s ^= _s << 17;
+            return _s;
+        }
+        //Uniform in [0, n).
+        uint64_t below(uint64_t n) {
+            return (*this)() % n;
+        }
+    private:
+        uint64_t _s;
+    };
+
+    //Print one result line as millions of operations per second.
+    inline void report(const char* name, double ops, double seconds) {
+        printf("%-40s %10.2f Mops/s\n", name, ops / seconds / 1e6);
+    }
+
+    //Keep the optimizer from dropping a computed value.
+    template<class T>
+    inline void keep(const T& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+}
+
+#endif
@@ -0,0 +1,109 @@
+//Hit, miss and eviction throughput of the caches in my_lru_cache.h, then a
+//cache-aside workload on sharded_cache across thread counts. One shard is
+//the single mutex baseline.
+//Usage: cache_bench [ops] [max threads, default the core count]
+//Build: g++ -std=c++11 -O2 -pthread -I.. cache_bench.cpp -o cache_bench
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "../my_lru_cache.h"
+
+typedef mystl::lru_cache<uint64_t, uint64_t> lru_type;
+typedef mystl::clock_cache<uint64_t, uint64_t> clock_type;
+
+template<class Cache>
+static void run_single(const char* name, size_t capacity, size_t ops) {
+    printf("%s, capacity %zu\n", name, capacity);
+    Cache c(capacity);
+    for (uint64_t k = 0; k < capacity; ++k)
+        c.put(k, k);
+    bench::xorshift rng;
+    uint64_t sum = 0;
+
+    //Every key is resident.
+    double t0 = bench::now();
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t* v = c.get(rng.below(capacity));
+        sum += v ? *v : 0;
+    }
+    double t1 = bench::now();
+    bench::report("  hit", (double)ops, t1 - t0);
+
+    //No key is resident.
+    t0 = bench::now();
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t* v = c.get(capacity + rng.below(capacity));
+        sum += v ? *v : 0;
+    }
+    t1 = bench::now();
+    bench::report("  miss", (double)ops, t1 - t0);
+
+    //Every put brings a new key and evicts one.
+    t0 = bench::now();
+    for (size_t i = 0; i < ops; ++i)
+        c.put(capacity + i, i);
+    t1 = bench::now();
+    bench::report("  put with eviction", (double)ops, t1 - t0);
+    bench::keep(sum);
+}
+
+//Each thread looks a key up and fills it on a miss. Keys are drawn from
+//twice the capacity, a skewed half of them four times as often.
+template<class Cache>
+static void worker(mystl::sharded_cache<Cache>* c, size_t capacity, size_t ops, uint64_t seed,
+        uint64_t* hits) {
+    bench::xorshift rng(seed);
+    uint64_t n = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t r = rng();
+        uint64_t k = (r & 7) < 6 ? r % (capacity / 2) : r % (capacity * 2);
+        uint64_t v;
+        if (c->get(k, v))
+            ++n;
+        else
+            c->put(k, k);
+    }
+    *hits = n;
+}
+
+template<class Cache>
+static void run_sharded(const char* name, size_t capacity, size_t shards, size_t threads,
+        size_t ops) {
+    mystl::sharded_cache<Cache> c(capacity, shards);
+    std::vector<std::thread> pool;
+    std::vector<uint64_t> hits(threads);
+    double t0 = bench::now();
+    for (size_t t = 0; t < threads; ++t)
+        pool.push_back(std::thread(worker<Cache>, &c, capacity, ops, t + 1, &hits[t]));
+    for (size_t t = 0; t < threads; ++t)
+        pool[t].join();
+    double t1 = bench::now();
+    uint64_t total = 0;
+    for (size_t t = 0; t < threads; ++t)
+        total += hits[t];
+    char label[80];
+    snprintf(label, sizeof(label), "  %s, %zu shards, %zu threads", name, shards, threads);
+    bench::report(label, (double)ops * threads, t1 - t0);
+    printf("%45s hit rate %.2f\n", "", (double)total / ((double)ops * threads));
+}
+
+int main(int argc, char** argv) {
+    size_t ops = argc > 1 ? (size_t)atol(argv[1]) : 2000000;
+    size_t capacity = 1 << 16;
+    run_single<lru_type>("lru_cache", capacity, ops);
+    run_single<clock_type>("clock_cache", capacity, ops);
+
+    size_t most = argc > 2 ? (size_t)atol(argv[2]) : std::thread::hardware_concurrency();
+    if (most == 0)
+        most = 4;
+    printf("sharded_cache, cache-aside, capacity %zu\n", capacity);
+    for (size_t threads = 1; threads <= most; threads *= 2) {
+        run_sharded<lru_type>("lru", capacity, 1, threads, ops / threads);
+        run_sharded<lru_type>("lru", capacity, 16, threads, ops / threads);
+        run_sharded<clock_type>("clock", capacity, 1, threads, ops / threads);
+        run_sharded<clock_type>("clock", capacity, 16, threads, ops / threads);
+    }
+    return 0;
+}
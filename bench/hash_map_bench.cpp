@@ -0,0 +1,90 @@
+//Read-mostly and write-heavy scaling of concurrent_hash_map across thread
+//counts, against one std::unordered_map behind a single mutex.
+//Usage: hash_map_bench [ops per thread] [max threads, default the core count]
+//Build: g++ -std=c++11 -O2 -pthread -I.. hash_map_bench.cpp -o hash_map_bench
+#include <stdint.h>
+#include <stdlib.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "bench.h"
+#include "../my_concurrent_hash_map.h"
+
+static const uint64_t key_count = 1 << 20;
+
+//The single mutex baseline.
+class locked_map {
+public:
+    bool find(uint64_t key, uint64_t& value) const {
+        std::lock_guard<std::mutex> guard(_lock);
+        std::unordered_map<uint64_t, uint64_t>::const_iterator i = _map.find(key);
+        if (i == _map.end())
+            return false;
+        value = i->second;
+        return true;
+    }
+    bool insert_or_assign(uint64_t key, uint64_t value) {
+        std::lock_guard<std::mutex> guard(_lock);
+        bool inserted = _map.find(key) == _map.end();
+        _map[key] = value;
+        return inserted;
+    }
+private:
+    mutable std::mutex _lock;
+    std::unordered_map<uint64_t, uint64_t> _map;
+};
+
+//writes out of every 100 operations are insert_or_assign, the rest find.
+template<class Map>
+static void worker(Map* m, size_t ops, unsigned writes, uint64_t seed, uint64_t* found) {
+    bench::xorshift rng(seed);
+    uint64_t n = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        uint64_t r = rng();
+        uint64_t k = (r >> 8) % key_count;
+        if (r % 100 < writes) {
+            m->insert_or_assign(k, i);
+        } else {
+            uint64_t v;
+            n += m->find(k, v);
+        }
+    }
+    *found = n;
+}
+
+template<class Map>
+static void run(const char* name, unsigned writes, size_t threads, size_t ops) {
+    Map m;
+    for (uint64_t k = 0; k < key_count; k += 2)
+        m.insert_or_assign(k, k);
+    std::vector<std::thread> pool;
+    std::vector<uint64_t> found(threads);
+    double t0 = bench::now();
+    for (size_t t = 0; t < threads; ++t)
+        pool.push_back(std::thread(worker<Map>, &m, ops, writes, t + 1, &found[t]));
+    for (size_t t = 0; t < threads; ++t)
+        pool[t].join();
+    double t1 = bench::now();
+    char label[80];
+    snprintf(label, sizeof(label), "  %s, %zu threads", name, threads);
+    bench::report(label, (double)ops * threads, t1 - t0);
+}
+
+int main(int argc, char** argv) {
+    size_t ops = argc > 1 ? (size_t)atol(argv[1]) : 2000000;
+    size_t most = argc > 2 ? (size_t)atol(argv[2]) : std::thread::hardware_concurrency();
+    if (most == 0)
+        most = 4;
+    typedef mystl::concurrent_hash_map<uint64_t, uint64_t> map_type;
+    unsigned mixes[] = {5, 50};
+    for (size_t k = 0; k < sizeof(mixes) / sizeof(mixes[0]); ++k) {
+        printf("%u%% reads, %u%% writes, %llu keys\n", 100 - mixes[k], mixes[k],
+                (unsigned long long)key_count);
+        for (size_t threads = 1; threads <= most; threads *= 2) {
+            run<map_type>("concurrent_hash_map", mixes[k], threads, ops);
+            run<locked_map>("unordered_map + mutex", mixes[k], threads, ops);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+//Push/pop heavy timer workload for the heap containers of my_queue.h.
+//A fixed number of timers is live. Each step fires the earliest one and
+//schedules a new timer a random delay later, like a timer wheel fallback.
+//The indexed heap also reschedules a live timer every step, the case that
+//needs addressable handles.
+//Build: g++ -std=c++11 -O2 -I.. heap_bench.cpp -o heap_bench
+#include <stdint.h>
+#include <stdlib.h>
+#include <queue>
+#include <vector>
+#include <functional>
+#include "bench.h"
+#include "../my_queue.h"
+
+static const uint64_t max_delay = 1 << 20;
+
+template<class Queue>
+static void run_queue(const char* name, size_t live, size_t steps) {
+    bench::xorshift rng;
+    Queue q;
+    for (size_t i = 0; i < live; ++i)
+        q.push(rng.below(max_delay));
+    double t0 = bench::now();
+    uint64_t now = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        now = q.top();
+        q.pop();
+        q.push(now + 1 + rng.below(max_delay));
+    }
+    double t1 = bench::now();
+    bench::keep(now);
+    bench::report(name, (double)steps, t1 - t0);
+}
+
+static void run_indexed(const char* name, size_t live, size_t steps) {
+    typedef mystl::indexed_heap<uint64_t, mystl::greater<uint64_t> > heap_type;
+    bench::xorshift rng;
+    heap_type q;
+    for (size_t i = 0; i < live; ++i)
+        q.push(rng.below(max_delay));
+    double t0 = bench::now();
+    uint64_t now = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        now = q.top();
+        q.pop();
+        q.push(now + 1 + rng.below(max_delay));
+        //The fired handle is reused by the push, so handles stay 0..live-1.
+        //Reschedule one of them later, it moves away from the top.
+        heap_type::handle_type r = rng.below(live);
+        q.update(r, q.get(r) + rng.below(max_delay));
+    }
+    double t1 = bench::now();
+    bench::keep(now);
+    bench::report(name, (double)steps, t1 - t0);
+}
+
+int main(int argc, char** argv) {
+    size_t steps = argc > 1 ? (size_t)atol(argv[1]) : 2000000;
+    size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        size_t live = sizes[k];
+        printf("%zu live timers, %zu fire+schedule steps\n", live, steps);
+        run_queue<std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t> > >(
+                "  std::priority_queue", live, steps);
+        run_queue<mystl::priority_queue<uint64_t, mystl::vector<uint64_t>, mystl::greater<uint64_t> > >(
+                "  mystl::priority_queue (binary)", live, steps);
+        run_queue<mystl::dary_priority_queue<uint64_t, 4, mystl::vector<uint64_t>, mystl::greater<uint64_t> > >(
+                "  mystl::dary_priority_queue<4>", live, steps);
+        run_queue<mystl::dary_priority_queue<uint64_t, 8, mystl::vector<uint64_t>, mystl::greater<uint64_t> > >(
+                "  mystl::dary_priority_queue<8>", live, steps);
+        run_indexed("  mystl::indexed_heap + reschedule", live, steps);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+//Scan throughput of a fragmented list, before and after compact.
+//The list is built in order, then its nodes are relinked in a random order,
+//so the walk jumps around the heap the way it does after long churn. The
+//scan is timed plain, with for_each_prefetch, and again after compact.
+//Build: g++ -std=c++11 -O2 -I.. list_bench.cpp -o list_bench
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include "bench.h"
+#include "../my_list.h"
+
+typedef mystl::list<uint64_t> list_type;
+
+class summer {
+public:
+    uint64_t sum;
+    summer(): sum(0) {}
+    void operator()(uint64_t v) {
+        sum += v * 3 + 1;
+    }
+};
+
+//Relink every node to the back in a random order.
+static void fragment(list_type& l) {
+    std::vector<list_type::iterator> nodes;
+    for (list_type::iterator i = l.begin(); i != l.end(); ++i)
+        nodes.push_back(i);
+    bench::xorshift rng;
+    for (size_t i = nodes.size(); i > 1; --i)
+        std::swap(nodes[i - 1], nodes[rng.below(i)]);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        list_type::iterator last = l.end();
+        --last;
+        l.splice(last, l, nodes[i]);
+    }
+}
+
+static void scan(const char* name, list_type& l, int rounds) {
+    double t0 = bench::now();
+    summer s;
+    for (int r = 0; r < rounds; ++r) {
+        for (list_type::iterator i = l.begin(); i != l.end(); ++i)
+            s(*i);
+    }
+    double t1 = bench::now();
+    bench::keep(s.sum);
+    bench::report(name, (double)l.size() * rounds, t1 - t0);
+}
+
+static void scan_prefetch(const char* name, list_type& l, int rounds) {
+    double t0 = bench::now();
+    uint64_t sum = 0;
+    for (int r = 0; r < rounds; ++r)
+        sum += l.for_each_prefetch(summer()).sum;
+    double t1 = bench::now();
+    bench::keep(sum);
+    bench::report(name, (double)l.size() * rounds, t1 - t0);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? (size_t)atol(argv[1]) : 4000000;
+    int rounds = 5;
+    list_type l;
+    for (size_t i = 0; i < n; ++i)
+        l.push_back(i);
+    printf("%zu elements, %d scans each\n", n, rounds);
+    scan("  in order", l, rounds);
+    fragment(l);
+    scan("  fragmented", l, rounds);
+    scan_prefetch("  fragmented, for_each_prefetch", l, rounds);
+    double t0 = bench::now();
+    l.compact();
+    double t1 = bench::now();
+    printf("  compact took %.1f ms\n", (t1 - t0) * 1e3);
+    scan("  compacted", l, rounds);
+    scan_prefetch("  compacted, for_each_prefetch", l, rounds);
+    return 0;
+}
@@ -1,55 +1,164 @@
 #ifndef MY_ALGOBASE_H
 #define MY_ALGOBASE_H
 
+#include <stddef.h>
+#include <string.h>
+#include "my_construct.h"
+#include "my_iterator.h"
+#include "my_type_traits.h"
+
 namespace mystl {
 
+    //Dispatch for bulk memory kernels.
+    //Trivially copyable ranges that are contiguous on both sides are copied
+    //with one memmove instead of one element per iteration.
+    class _loop_copy_tag {};
+    class _bulk_copy_tag {};
+    class _reverse_bulk_copy_tag {};
+
+    template<class InputIterator, class OutputIterator>
+    class _is_same_trivial_value: public integral_constant<bool,
+            is_same<typename remove_const<typename iterator_traits<InputIterator>::value_type>::type,
+                    typename iterator_traits<OutputIterator>::value_type>::value
+            && is_trivially_copyable<typename iterator_traits<OutputIterator>::value_type>::value> {};
+
+    //Kernel to copy from InputIterator to OutputIterator.
+    template<class InputIterator, class OutputIterator,
+            bool Bulk = is_contiguous_iterator<InputIterator>::value
+                && is_contiguous_iterator<OutputIterator>::value,
+            bool ReverseBulk = is_reverse_contiguous_iterator<InputIterator>::value
+                && is_reverse_contiguous_iterator<OutputIterator>::value>
+    class _copy_category {
+    public:
+        typedef _loop_copy_tag type;
+    };
+    template<class InputIterator, class OutputIterator>
+    class _copy_category<InputIterator, OutputIterator, true, false> {
+    public:
+        typedef typename conditional<_is_same_trivial_value<InputIterator, OutputIterator>::value,
+                _bulk_copy_tag, _loop_copy_tag>::type type;
+    };
+    template<class InputIterator, class OutputIterator>
+    class _copy_category<InputIterator, OutputIterator, false, true> {
+    public:
+        typedef typename conditional<_is_same_trivial_value<InputIterator, OutputIterator>::value,
+                _reverse_bulk_copy_tag, _loop_copy_tag>::type type;
+    };
+
+    //Byte sized scalars in contiguous storage can be filled with memset.
+    template<class ForwardIterator>
+    class _is_byte_fillable: public integral_constant<bool,
+            is_contiguous_iterator<ForwardIterator>::value
+            && is_scalar<typename iterator_traits<ForwardIterator>::value_type>::value
+            && sizeof(typename iterator_traits<ForwardIterator>::value_type) == 1> {};
+
     //Copy content between two iterator.
     template<class InputIterator, class OutputIterator>
-    OutputIterator copy(InputIterator first, InputIterator last, OutputIterator des) {
+    OutputIterator _copy(InputIterator first, InputIterator last, OutputIterator des, _loop_copy_tag) {
         for ( ; first != last; ++first) {
             *des = *first;
             ++des;
         }
         return des;
     }
+    template<class InputIterator, class OutputIterator>
+    OutputIterator _copy(InputIterator first, InputIterator last, OutputIterator des, _bulk_copy_tag) {
+        ptrdiff_t n = last - first;
+        if (n > 0)
+            memmove(_to_address(des), _to_address(first), n * sizeof(*_to_address(first)));
+        return des + n;
+    }
+    //A reversed contiguous range covers the same bytes, walked from the other end.
+    template<class InputIterator, class OutputIterator>
+    OutputIterator _copy(InputIterator first, InputIterator last, OutputIterator des, _reverse_bulk_copy_tag) {
+        ptrdiff_t n = last - first;
+        if (n > 0)
+            memmove(_to_address(des.base() - n), _to_address(last.base()),
+                    n * sizeof(*_to_address(last.base())));
+        return des + n;
+    }
+    template<class InputIterator, class OutputIterator>
+    OutputIterator copy(InputIterator first, InputIterator last, OutputIterator des) {
+        return _copy(first, last, des, typename _copy_category<InputIterator, OutputIterator>::type());
+    }
+
     //Copy from back.
     template<class BidirectionalIterator1, class BidirectionalIterator2>
-    BidirectionalIterator2 copy_backwd(BidirectionalIterator1 first, BidirectionalIterator1 last,
-            BidirectionalIterator2 des_last) {
+    BidirectionalIterator2 _copy_backwd(BidirectionalIterator1 first, BidirectionalIterator1 last,
+            BidirectionalIterator2 des_last, _loop_copy_tag) {
         while (last != first) {
             *(--des_last) = *(--last);
         }
         return des_last;
-        
     }
-    //Fill space with value.
-    template<class ForwardIterator, class T>
-    void fill(ForwardIterator first, ForwardIterator last, const T& value) {
-        for ( ; first != last; ++first) {
-            *first = value;
-        }
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    BidirectionalIterator2 _copy_backwd(BidirectionalIterator1 first, BidirectionalIterator1 last,
+            BidirectionalIterator2 des_last, _bulk_copy_tag) {
+        ptrdiff_t n = last - first;
+        if (n > 0)
+            memmove(_to_address(des_last - n), _to_address(first), n * sizeof(*_to_address(first)));
+        return des_last - n;
+    }
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    BidirectionalIterator2 _copy_backwd(BidirectionalIterator1 first, BidirectionalIterator1 last,
+            BidirectionalIterator2 des_last, _reverse_bulk_copy_tag) {
+        ptrdiff_t n = last - first;
+        if (n > 0)
+            memmove(_to_address(des_last.base()), _to_address(last.base()),
+                    n * sizeof(*_to_address(last.base())));
+        return des_last - n;
     }
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    BidirectionalIterator2 copy_backwd(BidirectionalIterator1 first, BidirectionalIterator1 last,
+            BidirectionalIterator2 des_last) {
+        return _copy_backwd(first, last, des_last,
+                typename _copy_category<BidirectionalIterator1, BidirectionalIterator2>::type());
+    }
+
     //Fill sapce with n value.
     template<class OutputIterator, class Size, class T>
-    void fill_n(OutputIterator first, Size n, const T& value) {
+    OutputIterator _fill_n(OutputIterator first, Size n, const T& value, false_type) {
         for ( ; n > 0; n--) {
             *first = value;
             ++first;
         }
+        return first;
     }
-
-    //Get address.
-    template<class T>
-    T* addressof(T& value) {
-        return reinterpret_cast<T*>(&const_cast<char&>(reinterpret_cast<const volatile char&>(value)));
+    template<class OutputIterator, class Size, class T>
+    OutputIterator _fill_n(OutputIterator first, Size n, const T& value, true_type) {
+        if (n > 0) {
+            typename iterator_traits<OutputIterator>::value_type byte = value;
+            memset(_to_address(first), *reinterpret_cast<unsigned char*>(&byte), n);
+            first += n;
+        }
+        return first;
+    }
+    template<class OutputIterator, class Size, class T>
+    void fill_n(OutputIterator first, Size n, const T& value) {
+        _fill_n(first, n, value, typename _is_byte_fillable<OutputIterator>::type());
+    }
+    //Fill space with value.
+    template<class ForwardIterator, class T>
+    void _fill(ForwardIterator first, ForwardIterator last, const T& value, false_type) {
+        for ( ; first != last; ++first) {
+            *first = value;
+        }
+    }
+    template<class ForwardIterator, class T>
+    void _fill(ForwardIterator first, ForwardIterator last, const T& value, true_type) {
+        _fill_n(first, last - first, value, true_type());
+    }
+    template<class ForwardIterator, class T>
+    void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+        _fill(first, last, value, typename _is_byte_fillable<ForwardIterator>::type());
     }
 
-	//Swap two object.
+	//Swap two object by moving, so containers swap their buffers.
 	template<class T>
 	void swap(T& a, T& b) {
-		T temp(a);
-		a = b;
-		b = temp;
+		T temp(mystl::move(a));
+		a = mystl::move(b);
+		b = mystl::move(temp);
 	}
 	//Swap objects in range.
 	template<class ForwardIterator1, class ForwardIterator2>
@@ -60,6 +169,31 @@ namespace mystl {
 		}
 		return first2;
 	}
+	//Reverse elements in range.
+	template<class BidirectionalIterator>
+	void reverse(BidirectionalIterator first, BidirectionalIterator last) {
+		while (first != last && first != --last) {
+			swap(*first, *last);
+			++first;
+		}
+	}
+	//Rotate [first, last) so that middle becomes the first element.
+	//Return the new position of the old first element.
+	template<class BidirectionalIterator>
+	BidirectionalIterator rotate(BidirectionalIterator first, BidirectionalIterator middle,
+			BidirectionalIterator last) {
+		if (first == middle)
+			return last;
+		if (middle == last)
+			return first;
+		reverse(first, middle);
+		reverse(middle, last);
+		reverse(first, last);
+		BidirectionalIterator result = first;
+		for (BidirectionalIterator i = middle; i != last; ++i)
+			++result;
+		return result;
+	}
 }
 
 #endif
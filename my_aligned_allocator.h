@@ -0,0 +1,135 @@
+#ifndef MY_ALIGNED_ALLOCATOR_H
+#define MY_ALIGNED_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdexcept>
+#include "my_allocator.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace mystl {
+
+    //Allocator returning storage aligned to Align bytes, e.g. 64 for SIMD
+    //loads that must not cross a cache line.
+    template<class T, size_t Align = 64>
+    class aligned_allocator: public allocator<T> {
+    public:
+        typedef typename allocator<T>::pointer pointer;
+        typedef typename allocator<T>::size_type size_type;
+
+        static const size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+        template<class U>
+        class rebind {
+        public:
+            typedef aligned_allocator<U, Align> other;
+        };
+
+        //Contructors
+        aligned_allocator() {}
+        template<class U>
+        aligned_allocator(const aligned_allocator<U, Align>&) {}
+
+        pointer allocate(size_type n, const void* = 0) {
+            return (pointer) _aligned_allocate(n * sizeof(T), alignment);
+        }
+        void deallocate(pointer p, size_type) {
+            _aligned_deallocate(p, alignment);
+        }
+    };
+
+    //Allocator backing large buffers with 2 MB pages, so a 20 GB vector needs
+    //10 thousand TLB entries instead of 5 million.
+    //Buffers of at least huge_page_size bytes are mapped with MAP_HUGETLB from
+    //the reserved huge page pool. When the pool is empty, they fall back to a
+    //2 MB aligned mapping marked MADV_HUGEPAGE for transparent huge pages.
+    //Smaller buffers come from the heap, 64 byte aligned.
+    template<class T>
+    class hugepage_allocator: public allocator<T> {
+    public:
+        typedef typename allocator<T>::pointer pointer;
+        typedef typename allocator<T>::size_type size_type;
+
+        static const size_t huge_page_size = (size_t)2 << 20;
+        static const size_t small_alignment = 64;
+
+        template<class U>
+        class rebind {
+        public:
+            typedef hugepage_allocator<U> other;
+        };
+
+        //Contructors
+        hugepage_allocator() {}
+        template<class U>
+        hugepage_allocator(const hugepage_allocator<U>&) {}
+
+        pointer allocate(size_type n, const void* = 0) {
+            size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+            if (bytes >= huge_page_size)
+                return (pointer) map_huge(round_up(bytes));
+#endif
+            return (pointer) _aligned_allocate(bytes, small_alignment);
+        }
+        void deallocate(pointer p, size_type n) {
+            size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+            if (bytes >= huge_page_size) {
+                munmap(p, round_up(bytes));
+                return;
+            }
+#endif
+            _aligned_deallocate(p, small_alignment);
+        }
+    private:
+        static size_t round_up(size_t bytes) {
+            return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+        }
+#if defined(__linux__)
+        static void* map_huge(size_t bytes) {
+            void* p;
+#if defined(MAP_HUGETLB)
+            p = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (MAP_FAILED != p)
+                return p;
+#endif
+            //Map one extra huge page and trim both ends to get 2 MB alignment,
+            //otherwise the kernel can not back the range with huge pages.
+            char* raw = (char*) mmap(0, bytes + huge_page_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED == (void*) raw)
+                throw std::bad_alloc();
+            size_t head = (huge_page_size - ((size_t) raw & (huge_page_size - 1))) & (huge_page_size - 1);
+            if (head)
+                munmap(raw, head);
+            munmap(raw + head + bytes, huge_page_size - head);
+            p = raw + head;
+#if defined(MADV_HUGEPAGE)
+            madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+            return p;
+        }
+#endif
+    };
+
+    template<class T, class U, size_t Align>
+    bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+        return true;
+    }
+    template<class T, class U, size_t Align>
+    bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+        return false;
+    }
+    template<class T, class U>
+    bool operator==(const hugepage_allocator<T>&, const hugepage_allocator<U>&) {
+        return true;
+    }
+    template<class T, class U>
+    bool operator!=(const hugepage_allocator<T>&, const hugepage_allocator<U>&) {
+        return false;
+    }
+}
+
+#endif
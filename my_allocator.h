@@ -2,11 +2,31 @@
 #define MY_ALLOCATOR_H
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <stdexcept>
 #include "my_construct.h"
+#include "my_type_traits.h"
 
 namespace mystl {
-    
+
+    //Allocate bytes aligned to align, a power of two.
+    //Plain operator new already covers alignments up to max_align_t.
+    inline void* _aligned_allocate(size_t bytes, size_t align) {
+        if (align <= alignof(max_align_t))
+            return ::operator new(bytes);
+        void* p = 0;
+        if (posix_memalign(&p, align, bytes ? bytes : align) != 0)
+            throw std::bad_alloc();
+        return p;
+    }
+    //Recall space from _aligned_allocate with the same align.
+    inline void _aligned_deallocate(void* p, size_t align) {
+        if (align <= alignof(max_align_t))
+            ::operator delete(p);
+        else
+            free(p);
+    }
+
     template<class T>
     class allocator {
     public:
@@ -18,6 +38,9 @@ namespace mystl {
         typedef const T& const_reference;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
+        //Stateless, any instance can free memory from any other.
+        typedef true_type propagate_on_container_move_assignment;
+        typedef true_type is_always_equal;
         
         template<class U>
         class rebind {
@@ -43,16 +66,13 @@ namespace mystl {
         }
 
         //Allocate space of n * size of value_type, if failed throw bad_alloc.
+        //Over-aligned types get storage aligned to alignof(value_type).
         pointer allocate(size_type n, const void* = 0) {
-            void* p = ::operator new(n * sizeof(value_type));
-            if (0 == p) {
-                throw std::bad_alloc();
-            }
-            return (pointer) p;
+            return (pointer) _aligned_allocate(n * sizeof(value_type), alignof(value_type));
         }
         //Recall space from p pointing to n value_type elements.
         void deallocate(pointer p, size_type) {
-            ::operator delete(p);
+            _aligned_deallocate(p, alignof(value_type));
         }
         //Construct a element with value x.
         void construct(pointer p, const_reference x) {
@@ -68,6 +88,94 @@ namespace mystl {
             return ((size_type)-1) / sizeof(value_type);
         }
     };
+
+    template<class T, class U>
+    bool operator==(const allocator<T>&, const allocator<U>&) {
+        return true;
+    }
+    template<class T, class U>
+    bool operator!=(const allocator<T>&, const allocator<U>&) {
+        return false;
+    }
+
+    //Allocator properties with defaults for members an allocator leaves out.
+    //Propagation defaults to false, is_always_equal to whether it is empty.
+    template<class Alloc, class = void>
+    class _alloc_pocca {
+    public:
+        typedef false_type type;
+    };
+    template<class Alloc>
+    class _alloc_pocca<Alloc, typename _void_type<typename Alloc::propagate_on_container_copy_assignment>::type> {
+    public:
+        typedef typename Alloc::propagate_on_container_copy_assignment type;
+    };
+    template<class Alloc, class = void>
+    class _alloc_pocma {
+    public:
+        typedef false_type type;
+    };
+    template<class Alloc>
+    class _alloc_pocma<Alloc, typename _void_type<typename Alloc::propagate_on_container_move_assignment>::type> {
+    public:
+        typedef typename Alloc::propagate_on_container_move_assignment type;
+    };
+    template<class Alloc, class = void>
+    class _alloc_pocs {
+    public:
+        typedef false_type type;
+    };
+    template<class Alloc>
+    class _alloc_pocs<Alloc, typename _void_type<typename Alloc::propagate_on_container_swap>::type> {
+    public:
+        typedef typename Alloc::propagate_on_container_swap type;
+    };
+    template<class Alloc, class = void>
+    class _alloc_always_equal {
+    public:
+        typedef typename is_empty<Alloc>::type type;
+    };
+    template<class Alloc>
+    class _alloc_always_equal<Alloc, typename _void_type<typename Alloc::is_always_equal>::type> {
+    public:
+        typedef typename Alloc::is_always_equal type;
+    };
+
+    template<class Alloc>
+    class allocator_traits {
+    public:
+        typedef Alloc allocator_type;
+        typedef typename Alloc::value_type value_type;
+        typedef typename Alloc::pointer pointer;
+        typedef typename Alloc::size_type size_type;
+        typedef typename _alloc_pocca<Alloc>::type propagate_on_container_copy_assignment;
+        typedef typename _alloc_pocma<Alloc>::type propagate_on_container_move_assignment;
+        typedef typename _alloc_pocs<Alloc>::type propagate_on_container_swap;
+        typedef typename _alloc_always_equal<Alloc>::type is_always_equal;
+
+        //Check if memory from r can be freed through l.
+        static bool equal(const Alloc& l, const Alloc& r) {
+            return _equal(l, r, is_always_equal());
+        }
+        //Take r's allocator when Propagate is true_type.
+        static void propagate(Alloc& l, const Alloc& r, true_type) {
+            l = r;
+        }
+        static void propagate(Alloc&, const Alloc&, false_type) {}
+        static void swap(Alloc& l, Alloc& r, true_type) {
+            Alloc temp(l);
+            l = r;
+            r = temp;
+        }
+        static void swap(Alloc&, Alloc&, false_type) {}
+    private:
+        static bool _equal(const Alloc&, const Alloc&, true_type) {
+            return true;
+        }
+        static bool _equal(const Alloc& l, const Alloc& r, false_type) {
+            return l == r;
+        }
+    };
 }
 
 
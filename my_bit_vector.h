@@ -0,0 +1,374 @@
+#ifndef MY_BIT_VECTOR_H
+#define MY_BIT_VECTOR_H
+
+#include <stddef.h>
+#include <stdexcept>
+#include "my_vector.h"
+
+namespace mystl {
+
+    typedef unsigned long long bit_word;
+
+    //Number of set bits in a word. Compiles to popcnt with -mpopcnt.
+    inline size_t _popcount(bit_word w) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(w);
+#else
+        size_t n = 0;
+        for ( ; w; w &= w - 1)
+            ++n;
+        return n;
+#endif
+    }
+    //Index of the lowest set bit, w must not be 0. Compiles to tzcnt with -mbmi.
+    inline size_t _count_trailing_zeros(bit_word w) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(w);
+#else
+        size_t n = 0;
+        for ( ; !(w & 1); w >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+    //Index of the k-th (from 0) set bit of w, w must have more than k set bits.
+    inline size_t _select_in_word(bit_word w, size_t k) {
+        for ( ; k > 0; --k)
+            w &= w - 1;
+        return _count_trailing_zeros(w);
+    }
+
+    //Bit packed vector, 64 bits per word.
+    //Bits past size() in the last word are always kept 0.
+    class bit_vector {
+    public:
+        typedef bit_word word_type;
+        typedef size_t size_type;
+        typedef bool value_type;
+
+        static const size_type bits_per_word = sizeof(word_type) * 8;
+        static const size_type npos = (size_type)-1;
+
+        //Proxy to a single bit.
+        class reference {
+        public:
+            reference(word_type* w, word_type mask): _word(w), _mask(mask) {}
+            operator bool() const {
+                return (*_word & _mask) != 0;
+            }
+            reference& operator=(bool value) {
+                if (value)
+                    *_word |= _mask;
+                else
+                    *_word &= ~_mask;
+                return *this;
+            }
+            reference& operator=(const reference& x) {
+                return *this = bool(x);
+            }
+            void flip() {
+                *_word ^= _mask;
+            }
+        private:
+            word_type* _word;
+            word_type _mask;
+        };
+        typedef bool const_reference;
+
+        //Constructors.
+        bit_vector(): _size(0) {}
+        explicit bit_vector(size_type n, bool value = false):
+            _words(word_count(n), value ? ~word_type(0) : word_type(0)), _size(n) {
+            clear_tail();
+        }
+
+        //Data access.
+        size_type size() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        //Number of words backing the bits.
+        size_type num_words() const {
+            return _words.size();
+        }
+        const word_type* data() const {
+            return _words.begin();
+        }
+        word_type* data() {
+            return _words.begin();
+        }
+        reference operator[](size_type n) {
+            return reference(&_words[n / bits_per_word], bit_mask(n));
+        }
+        const_reference operator[](size_type n) const {
+            return test(n);
+        }
+        bool test(size_type n) const {
+            return (_words[n / bits_per_word] & bit_mask(n)) != 0;
+        }
+        bool at(size_type n) const {
+            if (n >= _size)
+                throw std::out_of_range("my_bit_vector access out of range");
+            return test(n);
+        }
+
+        //Single bit operations.
+        void set(size_type n) {
+            _words[n / bits_per_word] |= bit_mask(n);
+        }
+        void set(size_type n, bool value) {
+            operator[](n) = value;
+        }
+        void reset(size_type n) {
+            _words[n / bits_per_word] &= ~bit_mask(n);
+        }
+        void flip(size_type n) {
+            _words[n / bits_per_word] ^= bit_mask(n);
+        }
+
+        //Whole vector operations, one word at a time.
+        void set() {
+            fill_n(_words.begin(), _words.size(), ~word_type(0));
+            clear_tail();
+        }
+        void reset() {
+            fill_n(_words.begin(), _words.size(), word_type(0));
+        }
+        void flip() {
+            for (size_type i = 0; i < _words.size(); ++i)
+                _words[i] = ~_words[i];
+            clear_tail();
+        }
+        //Number of set bits.
+        size_type count() const {
+            size_type n = 0;
+            for (size_type i = 0; i < _words.size(); ++i)
+                n += _popcount(_words[i]);
+            return n;
+        }
+        bool any() const {
+            for (size_type i = 0; i < _words.size(); ++i) {
+                if (_words[i])
+                    return true;
+            }
+            return false;
+        }
+        bool none() const {
+            return !any();
+        }
+        bool all() const {
+            return count() == _size;
+        }
+        //Position of the first set bit, npos if none.
+        size_type find_first() const {
+            return find_from_word(0);
+        }
+        //Position of the first set bit after n, npos if none.
+        size_type find_next(size_type n) const {
+            ++n;
+            if (n >= _size)
+                return npos;
+            size_type i = n / bits_per_word;
+            word_type w = _words[i] & (~word_type(0) << (n % bits_per_word));
+            if (w)
+                return i * bits_per_word + _count_trailing_zeros(w);
+            return find_from_word(i + 1);
+        }
+
+        bit_vector& operator&=(const bit_vector& x) {
+            check_size(x);
+            for (size_type i = 0; i < _words.size(); ++i)
+                _words[i] &= x._words[i];
+            return *this;
+        }
+        bit_vector& operator|=(const bit_vector& x) {
+            check_size(x);
+            for (size_type i = 0; i < _words.size(); ++i)
+                _words[i] |= x._words[i];
+            return *this;
+        }
+        bit_vector& operator^=(const bit_vector& x) {
+            check_size(x);
+            for (size_type i = 0; i < _words.size(); ++i)
+                _words[i] ^= x._words[i];
+            return *this;
+        }
+        //a - b: bits set in a but not in b.
+        bit_vector& operator-=(const bit_vector& x) {
+            check_size(x);
+            for (size_type i = 0; i < _words.size(); ++i)
+                _words[i] &= ~x._words[i];
+            return *this;
+        }
+        bit_vector operator~() const {
+            bit_vector temp(*this);
+            temp.flip();
+            return temp;
+        }
+
+        //Size changes.
+        void resize(size_type n, bool value = false) {
+            size_type old = _size;
+            _words.resize(word_count(n), value ? ~word_type(0) : word_type(0));
+            _size = n;
+            if (value && n > old && old % bits_per_word)
+                _words[old / bits_per_word] |= ~word_type(0) << (old % bits_per_word);
+            clear_tail();
+        }
+        void reserve(size_type n) {
+            _words.reserve(word_count(n));
+        }
+        void push_back(bool value) {
+            if (_size % bits_per_word == 0)
+                _words.push_back(word_type(0));
+            ++_size;
+            if (value)
+                set(_size - 1);
+        }
+        void pop_back() {
+            if (!empty()) {
+                reset(_size - 1);
+                --_size;
+                if (_size % bits_per_word == 0)
+                    _words.pop_back();
+            }
+        }
+        void clear() {
+            _words.clear();
+            _size = 0;
+        }
+        void swap(bit_vector& x) {
+            _words.swap(x._words);
+            mystl::swap(_size, x._size);
+        }
+
+        friend bool operator==(const bit_vector& l, const bit_vector& r) {
+            return l._size == r._size && l._words == r._words;
+        }
+    private:
+        vector<word_type> _words;
+        size_type _size;
+
+        static size_type word_count(size_type bits) {
+            return (bits + bits_per_word - 1) / bits_per_word;
+        }
+        static word_type bit_mask(size_type n) {
+            return word_type(1) << (n % bits_per_word);
+        }
+        //Keep the bits past _size at 0 so word-wise count and compare stay exact.
+        void clear_tail() {
+            if (_size % bits_per_word)
+                _words[_size / bits_per_word] &= ~(~word_type(0) << (_size % bits_per_word));
+        }
+        size_type find_from_word(size_type i) const {
+            for ( ; i < _words.size(); ++i) {
+                if (_words[i])
+                    return i * bits_per_word + _count_trailing_zeros(_words[i]);
+            }
+            return npos;
+        }
+        void check_size(const bit_vector& x) const {
+            if (_size != x._size)
+                throw std::invalid_argument("my_bit_vector size mismatch");
+        }
+    };
+
+    inline bit_vector operator&(const bit_vector& l, const bit_vector& r) {
+        bit_vector temp(l);
+        return temp &= r;
+    }
+    inline bit_vector operator|(const bit_vector& l, const bit_vector& r) {
+        bit_vector temp(l);
+        return temp |= r;
+    }
+    inline bit_vector operator^(const bit_vector& l, const bit_vector& r) {
+        bit_vector temp(l);
+        return temp ^= r;
+    }
+    inline bool operator!=(const bit_vector& l, const bit_vector& r) {
+        return !(l == r);
+    }
+    inline void swap(bit_vector& l, bit_vector& r) {
+        l.swap(r);
+    }
+
+    //Rank and select over a bit_vector.
+    //Stores a cumulative count every 8 words (512 bits), about 12.5% extra space.
+    //The bit_vector must outlive it and must not change after build.
+    class rank_select {
+    public:
+        typedef size_t size_type;
+
+        static const size_type words_per_block = 8;
+        static const size_type npos = bit_vector::npos;
+
+        rank_select(): _bits(0) {}
+        explicit rank_select(const bit_vector& bits) {
+            build(bits);
+        }
+
+        void build(const bit_vector& bits) {
+            _bits = &bits;
+            size_type n = bits.num_words();
+            const bit_word* w = bits.data();
+            _blocks.clear();
+            _blocks.reserve(n / words_per_block + 2);
+            size_type total = 0;
+            for (size_type i = 0; i < n; ++i) {
+                if (i % words_per_block == 0)
+                    _blocks.push_back(total);
+                total += _popcount(w[i]);
+            }
+            _blocks.push_back(total);
+        }
+        //Number of set bits in [0, n).
+        size_type rank1(size_type n) const {
+            size_type word = n / bit_vector::bits_per_word;
+            size_type block = word / words_per_block;
+            const bit_word* w = _bits->data();
+            size_type r = _blocks[block];
+            for (size_type i = block * words_per_block; i < word; ++i)
+                r += _popcount(w[i]);
+            if (n % bit_vector::bits_per_word)
+                r += _popcount(w[word] & ~(~bit_word(0) << (n % bit_vector::bits_per_word)));
+            return r;
+        }
+        //Number of unset bits in [0, n).
+        size_type rank0(size_type n) const {
+            return n - rank1(n);
+        }
+        //Total number of set bits.
+        size_type ones() const {
+            return _blocks.empty() ? 0 : _blocks.back();
+        }
+        //Position of the k-th (from 0) set bit, npos if there are not enough.
+        size_type select1(size_type k) const {
+            if (k >= ones())
+                return npos;
+            //Last block whose cumulative count is <= k.
+            size_type lo = 0, hi = _blocks.size() - 1;
+            while (hi - lo > 1) {
+                size_type mid = lo + (hi - lo) / 2;
+                if (_blocks[mid] <= k)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            k -= _blocks[lo];
+            const bit_word* w = _bits->data();
+            for (size_type i = lo * words_per_block; ; ++i) {
+                size_type c = _popcount(w[i]);
+                if (k < c)
+                    return i * bit_vector::bits_per_word + _select_in_word(w[i], k);
+                k -= c;
+            }
+        }
+    private:
+        const bit_vector* _bits;
+        vector<size_type> _blocks;
+    };
+}
+
+#endif
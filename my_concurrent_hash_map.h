@@ -0,0 +1,366 @@
+#ifndef MY_CONCURRENT_HASH_MAP_H
+#define MY_CONCURRENT_HASH_MAP_H
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include "my_memory"
+#include "my_function.h"
+#include "my_type_traits.h"
+
+namespace mystl {
+
+    //Tell the core we are spinning, does nothing where unsupported.
+    inline void _cpu_relax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#endif
+    }
+
+    //Hash map for many threads, split into shards by the high bits of the hash.
+    //Each shard is an open addressing table with linear probing, guarded by a
+    //mutex for writers and a sequence counter for readers: find takes no lock,
+    //copies the entry out, and retries if a writer ran meanwhile. Readers on
+    //different cores therefore share no written cache line.
+    //Entries are read while they may be written, so K and V must be trivially
+    //copyable; slots are stored as atomic words to keep such reads defined.
+    //Entries are copied out into default constructed ones, so K and V must
+    //also be default constructible.
+    //A table replaced by growth may still be read, it is freed with the map.
+    template<class K, class V, class Hash = hash<K> >
+    class concurrent_hash_map {
+        static_assert(is_trivially_copyable<K>::value && is_trivially_copyable<V>::value,
+                "concurrent_hash_map copies entries while they may change");
+        static_assert(is_default_constructible<K>::value && is_default_constructible<V>::value,
+                "concurrent_hash_map copies entries out into default constructed ones");
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef Hash hasher;
+        typedef size_t size_type;
+
+        //shards is rounded up to a power of two.
+        explicit concurrent_hash_map(size_type shards = 64, const Hash& hash = Hash()):
+            _count(1), _shift(0), _hash(hash) {
+            while (_count < shards)
+                _count *= 2;
+            while (((size_type)1 << _shift) < _count)
+                ++_shift;
+            _shards = shard_allocator.allocate(_count);
+            for (size_type i = 0; i < _count; ++i) {
+                new(_shards + i) shard();
+                _shards[i].current.store(new_table(min_capacity), std::memory_order_relaxed);
+            }
+        }
+        ~concurrent_hash_map() {
+            for (size_type i = 0; i < _count; ++i) {
+                table* t = _shards[i].current.load(std::memory_order_relaxed);
+                while (0 != t) {
+                    table* next = t->retired;
+                    delete_table(t);
+                    t = next;
+                }
+                _shards[i].~shard();
+            }
+            shard_allocator.deallocate(_shards, _count);
+        }
+
+        //Copy the value of key to value without locking, false if absent.
+        bool find(const key_type& key, mapped_type& value) const {
+            size_t h = tag(_hash(key));
+            const shard& s = pick(h);
+            for ( ; ; ) {
+                unsigned seq = s.seq.load(std::memory_order_acquire);
+                if (seq & 1) {
+                    _cpu_relax();
+                    continue;
+                }
+                const table* t = s.current.load(std::memory_order_acquire);
+                entry e;
+                bool found = probe(t, h, key, e) != npos;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) == seq) {
+                    if (found)
+                        value = e.value;
+                    return found;
+                }
+            }
+        }
+        bool contains(const key_type& key) const {
+            mapped_type value;
+            return find(key, value);
+        }
+        //Insert key if absent, return whether it was inserted.
+        bool insert(const key_type& key, const mapped_type& value) {
+            return put(key, value, false);
+        }
+        //Insert key or overwrite its value, return whether it was inserted.
+        bool insert_or_assign(const key_type& key, const mapped_type& value) {
+            return put(key, value, true);
+        }
+        bool erase(const key_type& key) {
+            size_t h = tag(_hash(key));
+            shard& s = pick(h);
+            std::lock_guard<std::mutex> guard(s.lock);
+            table* t = s.current.load(std::memory_order_relaxed);
+            entry e;
+            size_type i = probe(t, h, key, e);
+            if (i == npos)
+                return false;
+            begin_write(s);
+            erase_slot(t, i);
+            end_write(s);
+            s.size.store(s.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            return true;
+        }
+        //Call f(key, value) on every entry, one shard at a time under its lock.
+        template<class Function>
+        Function for_each(Function f) const {
+            for (size_type n = 0; n < _count; ++n) {
+                const shard& s = _shards[n];
+                std::lock_guard<std::mutex> guard(s.lock);
+                const table* t = s.current.load(std::memory_order_relaxed);
+                for (size_type i = 0; i < t->capacity; ++i) {
+                    if (t->slots[i].hash() != 0) {
+                        entry e = t->slots[i].load();
+                        f(e.key, e.value);
+                    }
+                }
+            }
+            return f;
+        }
+        //Erase every entry for which pred(key, value) holds, shard by shard
+        //under its lock. Return the number erased.
+        template<class Predicate>
+        size_type erase_if(Predicate pred) {
+            size_type erased = 0;
+            for (size_type n = 0; n < _count; ++n) {
+                shard& s = _shards[n];
+                std::lock_guard<std::mutex> guard(s.lock);
+                table* t = s.current.load(std::memory_order_relaxed);
+                begin_write(s);
+                //Walk down so a backward shift only moves entries already seen.
+                //Start after an empty slot, so no run wraps into the walk.
+                size_type start = 0;
+                while (t->slots[start].hash() != 0)
+                    ++start;
+                size_type i = start;
+                do {
+                    i = (i - 1) & t->mask;
+                    if (t->slots[i].hash() != 0) {
+                        entry e = t->slots[i].load();
+                        if (pred(e.key, e.value)) {
+                            erase_slot(t, i);
+                            ++erased;
+                            s.size.store(s.size.load(std::memory_order_relaxed) - 1,
+                                    std::memory_order_relaxed);
+                        }
+                    }
+                } while (i != start);
+                end_write(s);
+            }
+            return erased;
+        }
+        //Number of entries, exact only while no writer runs.
+        size_type size() const {
+            size_type n = 0;
+            for (size_type i = 0; i < _count; ++i)
+                n += _shards[i].size.load(std::memory_order_relaxed);
+            return n;
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+        size_type shard_count() const {
+            return _count;
+        }
+    private:
+        static const size_type npos = (size_type)-1;
+        static const size_type min_capacity = 16;
+
+        //Hash 0 marks an empty slot.
+        class entry {
+        public:
+            size_t hash;
+            key_type key;
+            mapped_type value;
+        };
+        //An entry kept as atomic words, hash first.
+        class slot {
+        public:
+            static const size_type words = (sizeof(entry) + sizeof(size_t) - 1) / sizeof(size_t);
+
+            std::atomic<size_t> w[words];
+
+            slot() {
+                for (size_type i = 0; i < words; ++i)
+                    w[i].store(0, std::memory_order_relaxed);
+            }
+
+            size_t hash() const {
+                return w[0].load(std::memory_order_relaxed);
+            }
+            entry load() const {
+                size_t buf[words];
+                for (size_type i = 0; i < words; ++i)
+                    buf[i] = w[i].load(std::memory_order_relaxed);
+                entry e;
+                memcpy(&e, buf, sizeof(e));
+                return e;
+            }
+            void store(const entry& e) {
+                size_t buf[words];
+                memset(buf, 0, sizeof(buf));
+                memcpy(buf, &e, sizeof(e));
+                for (size_type i = 0; i < words; ++i)
+                    w[i].store(buf[i], std::memory_order_relaxed);
+            }
+            void clear() {
+                w[0].store(0, std::memory_order_relaxed);
+            }
+        };
+        class table {
+        public:
+            slot* slots;
+            size_type capacity;
+            size_type mask;
+            //Older tables of the shard, kept until destruction.
+            table* retired;
+        };
+        class alignas(64) shard {
+        public:
+            std::atomic<unsigned> seq;
+            std::atomic<table*> current;
+            std::atomic<size_type> size;
+            mutable std::mutex lock;
+
+            shard(): seq(0), current(0), size(0) {}
+        };
+
+        shard* _shards;
+        size_type _count;
+        size_type _shift;
+        Hash _hash;
+        allocator<shard> shard_allocator;
+        allocator<table> table_allocator;
+        allocator<slot> slot_allocator;
+
+        concurrent_hash_map(const concurrent_hash_map&);
+        concurrent_hash_map& operator=(const concurrent_hash_map&);
+
+        static size_t tag(size_t h) {
+            return h == 0 ? 1 : h;
+        }
+        shard& pick(size_t h) {
+            return _shift == 0 ? _shards[0] : _shards[h >> (sizeof(size_t) * 8 - _shift)];
+        }
+        const shard& pick(size_t h) const {
+            return _shift == 0 ? _shards[0] : _shards[h >> (sizeof(size_t) * 8 - _shift)];
+        }
+        table* new_table(size_type capacity) {
+            table* t = table_allocator.allocate(1);
+            new(t) table();
+            t->slots = slot_allocator.allocate(capacity);
+            for (size_type i = 0; i < capacity; ++i)
+                new(t->slots + i) slot();
+            t->capacity = capacity;
+            t->mask = capacity - 1;
+            t->retired = 0;
+            return t;
+        }
+        void delete_table(table* t) {
+            for (size_type i = 0; i < t->capacity; ++i)
+                t->slots[i].~slot();
+            slot_allocator.deallocate(t->slots, t->capacity);
+            t->~table();
+            table_allocator.deallocate(t, 1);
+        }
+        //Slot of key copied to e, npos if absent. The probe is bounded, as a
+        //reader racing a writer may see a torn table.
+        static size_type probe(const table* t, size_t h, const key_type& key, entry& e) {
+            size_type i = h & t->mask;
+            for (size_type n = 0; n < t->capacity; ++n, i = (i + 1) & t->mask) {
+                size_t sh = t->slots[i].hash();
+                if (sh == 0)
+                    return npos;
+                if (sh == h) {
+                    e = t->slots[i].load();
+                    if (e.key == key)
+                        return i;
+                }
+            }
+            return npos;
+        }
+        //Writers make seq odd while they change the shard.
+        static void begin_write(shard& s) {
+            s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        static void end_write(shard& s) {
+            s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        static void place(table* t, const entry& e) {
+            size_type i = e.hash & t->mask;
+            while (t->slots[i].hash() != 0)
+                i = (i + 1) & t->mask;
+            t->slots[i].store(e);
+        }
+        //Empty slot i and shift later entries of its run back.
+        static void erase_slot(table* t, size_type i) {
+            size_type j = i;
+            for ( ; ; ) {
+                j = (j + 1) & t->mask;
+                size_t sh = t->slots[j].hash();
+                if (sh == 0)
+                    break;
+                size_type home = sh & t->mask;
+                bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                if (!stays) {
+                    t->slots[i].store(t->slots[j].load());
+                    i = j;
+                }
+            }
+            t->slots[i].clear();
+        }
+        bool put(const key_type& key, const mapped_type& value, bool assign) {
+            size_t h = tag(_hash(key));
+            shard& s = pick(h);
+            std::lock_guard<std::mutex> guard(s.lock);
+            table* t = s.current.load(std::memory_order_relaxed);
+            entry e;
+            size_type i = probe(t, h, key, e);
+            if (i != npos) {
+                if (assign) {
+                    e.value = value;
+                    begin_write(s);
+                    t->slots[i].store(e);
+                    end_write(s);
+                }
+                return false;
+            }
+            e.hash = h;
+            e.key = key;
+            e.value = value;
+            size_type n = s.size.load(std::memory_order_relaxed) + 1;
+            begin_write(s);
+            if (2 * n > t->capacity) {
+                //Grow to a new table, readers still on the old one retry.
+                table* bigger = new_table(2 * t->capacity);
+                for (size_type k = 0; k < t->capacity; ++k) {
+                    if (t->slots[k].hash() != 0)
+                        place(bigger, t->slots[k].load());
+                }
+                bigger->retired = t;
+                s.current.store(bigger, std::memory_order_release);
+                t = bigger;
+            }
+            place(t, e);
+            end_write(s);
+            s.size.store(n, std::memory_order_relaxed);
+            return true;
+        }
+    };
+}
+
+#endif
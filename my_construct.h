@@ -11,11 +11,27 @@ namespace mystl {
         new(p) T1(value);
     }
     
+    //Default-initialize in allocated space. Trivial types are left as they are.
+    template<class T>
+    void _default_construct(T* p) {
+        new(p) T;
+    }
+
+    //Tag to ask for default-initialization instead of value-initialization.
+    class default_init_t {};
+    const default_init_t default_init = default_init_t();
+
     //Destory object.
     template<class T>
     void _destroy(T* p) {
         p->~T();
     }
+
+    //Get address.
+    template<class T>
+    T* addressof(T& value) {
+        return reinterpret_cast<T*>(&const_cast<char&>(reinterpret_cast<const volatile char&>(value)));
+    }
 }
 
 #endif
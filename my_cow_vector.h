@@ -0,0 +1,271 @@
+#ifndef MY_COW_VECTOR_H
+#define MY_COW_VECTOR_H
+
+#include <stddef.h>
+#include <atomic>
+#include <stdexcept>
+#include "my_vector.h"
+
+namespace mystl {
+
+    //Copy-on-write vector for values passed around by copy and mostly read,
+    //e.g. one payload fanned out to many consumers. Copies share one buffer
+    //under an atomic reference count, so copying is O(1) whatever the size.
+    //The first change through a non-const member of a shared vector makes a
+    //private copy; make_unique does it explicitly.
+    //Const members read the buffer directly and never look at the count.
+    //References and iterators got through non-const members must not be
+    //written through after this vector has been copied.
+    template<class T, class Alloc = allocator<T> >
+    class cow_vector {
+    public:
+        typedef vector<T, Alloc> vector_type;
+        typedef Alloc allocator_type;
+        typedef T value_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef size_t size_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        //Constructors.
+        cow_vector(): _rep(0) {}
+        explicit cow_vector(size_type n, const value_type& value = value_type()):
+            _rep(n ? new rep(vector_type(n, value)) : 0) {}
+        template<class InputIterator>
+        cow_vector(InputIterator first, InputIterator last): _rep(0) {
+            vector_type v(first, last);
+            if (!v.empty())
+                _rep = new rep(mystl::move(v));
+        }
+        explicit cow_vector(const vector_type& v): _rep(v.empty() ? 0 : new rep(v)) {}
+        explicit cow_vector(vector_type&& v): _rep(v.empty() ? 0 : new rep(mystl::move(v))) {}
+        //Copy shares the buffer.
+        cow_vector(const cow_vector& x): _rep(x._rep) {
+            if (0 != _rep)
+                _rep->count.fetch_add(1, std::memory_order_relaxed);
+        }
+        cow_vector(cow_vector&& x): _rep(x._rep) {
+            x._rep = 0;
+        }
+        ~cow_vector() {
+            release(_rep);
+        }
+
+        cow_vector& operator=(const cow_vector& x) {
+            if (0 != x._rep)
+                x._rep->count.fetch_add(1, std::memory_order_relaxed);
+            rep* old = _rep;
+            _rep = x._rep;
+            release(old);
+            return *this;
+        }
+        cow_vector& operator=(cow_vector&& x) {
+            if (this != &x) {
+                release(_rep);
+                _rep = x._rep;
+                x._rep = 0;
+            }
+            return *this;
+        }
+
+        //Read access, never copies.
+        const_iterator begin() const {
+            return data();
+        }
+        const_iterator end() const {
+            return data() + size();
+        }
+        const_iterator cbegin() const {
+            return begin();
+        }
+        const_iterator cend() const {
+            return end();
+        }
+        const_pointer data() const {
+            return 0 != _rep ? _rep->values.begin() : 0;
+        }
+        size_type size() const {
+            return 0 != _rep ? _rep->values.size() : 0;
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+        size_type capacity() const {
+            return 0 != _rep ? _rep->values.capacity() : 0;
+        }
+        const_reference operator[](size_type n) const {
+            return _rep->values[n];
+        }
+        const_reference at(size_type n) const {
+            if (n >= size())
+                throw std::out_of_range("my_cow_vector access out of range");
+            return _rep->values[n];
+        }
+        const_reference front() const {
+            return _rep->values.front();
+        }
+        const_reference back() const {
+            return _rep->values.back();
+        }
+        //Number of vectors sharing the buffer, 0 when empty.
+        size_type use_count() const {
+            return 0 != _rep ? _rep->count.load(std::memory_order_relaxed) : 0;
+        }
+
+        //Take a private copy of the buffer if it is shared, and return it.
+        vector_type& make_unique() {
+            if (0 == _rep) {
+                _rep = new rep(vector_type());
+            } else if (_rep->count.load(std::memory_order_acquire) != 1) {
+                rep* copy = new rep(_rep->values);
+                release(_rep);
+                _rep = copy;
+            }
+            return _rep->values;
+        }
+
+        //Write access, copies a shared buffer first.
+        iterator begin() {
+            return empty() ? 0 : make_unique().begin();
+        }
+        iterator end() {
+            return empty() ? 0 : make_unique().end();
+        }
+        pointer data() {
+            return begin();
+        }
+        reference operator[](size_type n) {
+            return make_unique()[n];
+        }
+        reference at(size_type n) {
+            if (n >= size())
+                throw std::out_of_range("my_cow_vector access out of range");
+            return make_unique()[n];
+        }
+        reference front() {
+            return make_unique().front();
+        }
+        reference back() {
+            return make_unique().back();
+        }
+
+        //Modifiers. Ones that drop every element leave the shared buffer to
+        //its other owners instead of copying it.
+        void push_back(const value_type& value) {
+            make_unique().push_back(value);
+        }
+        void push_back(value_type&& value) {
+            make_unique().push_back(mystl::move(value));
+        }
+        void pop_back() {
+            make_unique().pop_back();
+            drop_if_empty();
+        }
+        //Positions may point into a buffer shared since they were taken, so
+        //their offset is taken before make_unique and rebased on its copy.
+        iterator insert(iterator position, const value_type& value) {
+            size_type pos = offset(position);
+            vector_type& v = make_unique();
+            return v.insert(v.begin() + pos, value);
+        }
+        template<class InputIterator>
+        iterator insert(iterator position, InputIterator first, InputIterator last) {
+            size_type pos = offset(position);
+            vector_type& v = make_unique();
+            return v.insert(v.begin() + pos, first, last);
+        }
+        iterator erase(iterator position) {
+            size_type pos = offset(position);
+            vector_type& v = make_unique();
+            v.erase(v.begin() + pos);
+            return drop_if_empty() ? 0 : _rep->values.begin() + pos;
+        }
+        iterator erase(iterator first, iterator last) {
+            size_type pos = offset(first);
+            size_type n = last - first;
+            if (n == 0)
+                return first;
+            if (n == size()) {
+                clear();
+                return 0;
+            }
+            vector_type& v = make_unique();
+            return v.erase(v.begin() + pos, v.begin() + pos + n);
+        }
+        void resize(size_type n, const value_type& value = value_type()) {
+            if (n == 0)
+                clear();
+            else
+                make_unique().resize(n, value);
+        }
+        void reserve(size_type n) {
+            make_unique().reserve(n);
+        }
+        void clear() {
+            release(_rep);
+            _rep = 0;
+        }
+        void swap(cow_vector& x) {
+            rep* temp = _rep;
+            _rep = x._rep;
+            x._rep = temp;
+        }
+    private:
+        //Shared buffer with the number of vectors holding it.
+        class rep {
+        public:
+            std::atomic<size_type> count;
+            vector_type values;
+
+            explicit rep(const vector_type& v): count(1), values(v) {}
+            explicit rep(vector_type&& v): count(1), values(mystl::move(v)) {}
+        };
+
+        rep* _rep;
+
+        //Offset of position in the current buffer, without copying it.
+        size_type offset(const_iterator position) const {
+            return position - data();
+        }
+
+        //The last owner frees the buffer, after every other owner's reads.
+        static void release(rep* r) {
+            if (0 != r && r->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete r;
+        }
+        //Free a buffer left empty, so empty vectors share nothing.
+        bool drop_if_empty() {
+            if (!_rep->values.empty())
+                return false;
+            release(_rep);
+            _rep = 0;
+            return true;
+        }
+    };
+
+    template<class T, class Alloc>
+    bool operator==(const cow_vector<T, Alloc>& l, const cow_vector<T, Alloc>& r) {
+        if (l.size() != r.size())
+            return false;
+        if (l.data() == r.data())
+            return true;
+        for (typename cow_vector<T, Alloc>::size_type i = 0; i < l.size(); ++i) {
+            if (l[i] != r[i])
+                return false;
+        }
+        return true;
+    }
+    template<class T, class Alloc>
+    bool operator!=(const cow_vector<T, Alloc>& l, const cow_vector<T, Alloc>& r) {
+        return !(l == r);
+    }
+    template<class T, class Alloc>
+    void swap(cow_vector<T, Alloc>& l, cow_vector<T, Alloc>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
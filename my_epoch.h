@@ -0,0 +1,190 @@
+#ifndef MY_EPOCH_H
+#define MY_EPOCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "my_memory"
+#include "my_vector.h"
+
+namespace mystl {
+
+    //Slot of one reader thread, on its own cache line so entering and
+    //leaving a read section writes only memory no other thread writes.
+    class alignas(64) epoch_record {
+    public:
+        //Epoch seen on entering the outermost read section, 0 outside.
+        std::atomic<uint64_t> epoch;
+        std::atomic<bool> in_use;
+        //Nesting depth of read sections, touched by the owner only.
+        unsigned depth;
+        epoch_record* next;
+
+        epoch_record(): epoch(0), in_use(true), depth(0), next(0) {}
+    };
+
+    //Epoch based reclamation.
+    //Readers announce the global epoch while they may hold pointers to shared
+    //objects. A writer that unpublishes an object retires it at the current
+    //epoch and moves the epoch on. The object is freed once every reader
+    //inside a read section has announced a later epoch, so no reader can
+    //still see it. Readers never wait and never write shared cache lines.
+    //Thread slots are registered on first use and reused after a thread exits.
+    //Each thread keeps its slot in one thread_local, so there is a single
+    //domain, reached through global().
+    class epoch_domain {
+    public:
+        typedef void (*deleter_type)(void*);
+
+        ~epoch_domain() {
+            for (size_t i = 0; i < _retired.size(); ++i)
+                _retired[i].deleter(_retired[i].object);
+            epoch_record* r = _records.load(std::memory_order_relaxed);
+            while (0 != r) {
+                epoch_record* next = r->next;
+                r->~epoch_record();
+                record_allocator.deallocate(r, 1);
+                r = next;
+            }
+        }
+
+        //Domain shared by the whole process.
+        static epoch_domain& global() {
+            static epoch_domain domain;
+            return domain;
+        }
+
+        //Enter a read section, sections nest.
+        void enter() {
+            epoch_record* r = local();
+            if (r->depth++ == 0) {
+                r->epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                //Publish the epoch before reading any shared pointer.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        void exit() {
+            epoch_record* r = local();
+            if (--r->depth == 0)
+                r->epoch.store(0, std::memory_order_release);
+        }
+        //Free object with deleter once no reader can hold it. The object must
+        //already be unreachable for new readers.
+        void retire(void* object, deleter_type deleter) {
+            std::lock_guard<std::mutex> guard(_lock);
+            retired r;
+            r.object = object;
+            r.deleter = deleter;
+            r.epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+            _retired.push_back(r);
+            collect_locked();
+        }
+        //Free what can be freed now, return the number still waiting.
+        size_t collect() {
+            std::lock_guard<std::mutex> guard(_lock);
+            return collect_locked();
+        }
+        //Wait until every object retired so far is freed. Must not be
+        //called inside a read section.
+        void synchronize() {
+            while (collect() != 0)
+                std::this_thread::yield();
+        }
+    private:
+        class retired {
+        public:
+            void* object;
+            deleter_type deleter;
+            uint64_t epoch;
+        };
+        //Releases the slot of a thread when it exits.
+        class thread_slot {
+        public:
+            epoch_record* record;
+
+            thread_slot(): record(0) {}
+            ~thread_slot() {
+                if (0 != record)
+                    record->in_use.store(false, std::memory_order_release);
+            }
+        };
+
+        std::atomic<uint64_t> _epoch;
+        std::atomic<epoch_record*> _records;
+        std::mutex _lock;
+        vector<retired> _retired;
+        allocator<epoch_record> record_allocator;
+
+        epoch_domain(): _epoch(1), _records(0) {}
+        epoch_domain(const epoch_domain&);
+        epoch_domain& operator=(const epoch_domain&);
+
+        epoch_record* local() {
+            static thread_local thread_slot slot;
+            if (0 == slot.record)
+                slot.record = acquire();
+            return slot.record;
+        }
+        epoch_record* acquire() {
+            for (epoch_record* r = _records.load(std::memory_order_acquire); r; r = r->next) {
+                bool expected = false;
+                if (!r->in_use.load(std::memory_order_relaxed)
+                        && r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return r;
+            }
+            epoch_record* r = record_allocator.allocate(1);
+            new(r) epoch_record();
+            epoch_record* head = _records.load(std::memory_order_relaxed);
+            do {
+                r->next = head;
+            } while (!_records.compare_exchange_weak(head, r, std::memory_order_release,
+                    std::memory_order_relaxed));
+            return r;
+        }
+        //Oldest epoch a reader may still be in.
+        uint64_t min_active() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint64_t m = (uint64_t)-1;
+            for (epoch_record* r = _records.load(std::memory_order_acquire); r; r = r->next) {
+                uint64_t e = r->epoch.load(std::memory_order_acquire);
+                if (e != 0 && e < m)
+                    m = e;
+            }
+            return m;
+        }
+        size_t collect_locked() {
+            if (_retired.empty())
+                return 0;
+            uint64_t m = min_active();
+            size_t kept = 0;
+            for (size_t i = 0; i < _retired.size(); ++i) {
+                //Readers that saw an epoch after the retiring one saw the
+                //object already unpublished.
+                if (_retired[i].epoch < m)
+                    _retired[i].deleter(_retired[i].object);
+                else
+                    _retired[kept++] = _retired[i];
+            }
+            _retired.resize(kept);
+            return kept;
+        }
+    };
+
+    //Read section of the global domain for the lifetime of the guard.
+    class epoch_guard {
+    public:
+        epoch_guard() {
+            epoch_domain::global().enter();
+        }
+        ~epoch_guard() {
+            epoch_domain::global().exit();
+        }
+    private:
+        epoch_guard(const epoch_guard&);
+        epoch_guard& operator=(const epoch_guard&);
+    };
+}
+
+#endif
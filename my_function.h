@@ -0,0 +1,87 @@
+#ifndef MY_FUNCTION_H
+#define MY_FUNCTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace mystl {
+
+    //Compare functors.
+    template<class T>
+    class less {
+    public:
+        bool operator()(const T& l, const T& r) const {
+            return l < r;
+        }
+    };
+    template<class T>
+    class greater {
+    public:
+        bool operator()(const T& l, const T& r) const {
+            return r < l;
+        }
+    };
+    template<class T>
+    class equal_to {
+    public:
+        bool operator()(const T& l, const T& r) const {
+            return l == r;
+        }
+    };
+
+    //Hash functors.
+    //Hash tables here index with the low bits of the hash, so integers are
+    //mixed instead of hashed to themselves.
+    inline size_t _hash_mix(uint64_t k) {
+        k ^= k >> 33;
+        k *= UINT64_C(0xff51afd7ed558ccd);
+        k ^= k >> 33;
+        k *= UINT64_C(0xc4ceb9fe1a85ec53);
+        k ^= k >> 33;
+        return (size_t)k;
+    }
+    //FNV-1a over n bytes.
+    inline size_t _hash_bytes(const void* p, size_t n) {
+        const unsigned char* c = (const unsigned char*)p;
+        uint64_t h = UINT64_C(14695981039346656037);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= c[i];
+            h *= UINT64_C(1099511628211);
+        }
+        return _hash_mix(h);
+    }
+
+    template<class T>
+    class hash;
+    template<class T>
+    class hash<T*> {
+    public:
+        size_t operator()(T* p) const {
+            return _hash_mix((uint64_t)(uintptr_t)p);
+        }
+    };
+#define MYSTL_INTEGRAL_HASH(T) \
+    template<> \
+    class hash<T> { \
+    public: \
+        size_t operator()(T x) const { \
+            return _hash_mix((uint64_t)x); \
+        } \
+    };
+    MYSTL_INTEGRAL_HASH(bool)
+    MYSTL_INTEGRAL_HASH(char)
+    MYSTL_INTEGRAL_HASH(signed char)
+    MYSTL_INTEGRAL_HASH(unsigned char)
+    MYSTL_INTEGRAL_HASH(wchar_t)
+    MYSTL_INTEGRAL_HASH(short)
+    MYSTL_INTEGRAL_HASH(unsigned short)
+    MYSTL_INTEGRAL_HASH(int)
+    MYSTL_INTEGRAL_HASH(unsigned int)
+    MYSTL_INTEGRAL_HASH(long)
+    MYSTL_INTEGRAL_HASH(unsigned long)
+    MYSTL_INTEGRAL_HASH(long long)
+    MYSTL_INTEGRAL_HASH(unsigned long long)
+#undef MYSTL_INTEGRAL_HASH
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef MY_HEAP_H
+#define MY_HEAP_H
+
+#include <stddef.h>
+#include "my_iterator.h"
+#include "my_function.h"
+
+namespace mystl {
+
+    //Heap algorithms over random access ranges, largest element first under comp.
+    //The d-ary versions take the arity D as first template argument, 2 gives the
+    //binary heap. Wider nodes make the tree shallower and keep siblings in one
+    //cache line, so pops touch fewer lines.
+
+    //Move value up from hole until its parent is not less than it.
+    template<size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+    void _push_heap(RandomAccessIterator first, Distance hole, Distance top, T value, Compare comp) {
+        Distance parent = (hole - 1) / Distance(D);
+        while (hole > top && comp(*(first + parent), value)) {
+            *(first + hole) = *(first + parent);
+            hole = parent;
+            parent = (hole - 1) / Distance(D);
+        }
+        *(first + hole) = value;
+    }
+    //Move the hole down to a leaf along the largest children, then push value up from there.
+    template<size_t D, class RandomAccessIterator, class Distance, class T, class Compare>
+    void _adjust_heap(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp) {
+        Distance top = hole;
+        Distance child = Distance(D) * hole + 1;
+        while (child < len) {
+            Distance best = child;
+            Distance end = child + Distance(D) < len ? child + Distance(D) : len;
+            for (Distance i = child + 1; i < end; ++i) {
+                if (comp(*(first + best), *(first + i)))
+                    best = i;
+            }
+            *(first + hole) = *(first + best);
+            hole = best;
+            child = Distance(D) * hole + 1;
+        }
+        _push_heap<D>(first, hole, top, value, comp);
+    }
+
+    //Push *(last - 1) into heap [first, last - 1).
+    template<size_t D, class RandomAccessIterator, class Compare>
+    void push_dary_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        T value = *(last - 1);
+        _push_heap<D>(first, Distance((last - first) - 1), Distance(0), value, comp);
+    }
+    //Move top to last - 1 and keep [first, last - 1) a heap.
+    template<size_t D, class RandomAccessIterator, class Compare>
+    void pop_dary_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (last - first < 2)
+            return;
+        --last;
+        T value = *last;
+        *last = *first;
+        _adjust_heap<D>(first, Distance(0), Distance(last - first), value, comp);
+    }
+    //Make [first, last) a heap.
+    template<size_t D, class RandomAccessIterator, class Compare>
+    void make_dary_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        Distance len = last - first;
+        if (len < 2)
+            return;
+        for (Distance parent = (len - 2) / Distance(D) + 1; parent > 0; --parent) {
+            T value = *(first + (parent - 1));
+            _adjust_heap<D>(first, parent - 1, len, value, comp);
+        }
+    }
+    //Sort heap [first, last) ascending.
+    template<size_t D, class RandomAccessIterator, class Compare>
+    void sort_dary_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        for ( ; last - first > 1; --last)
+            pop_dary_heap<D>(first, last, comp);
+    }
+    //Check if [first, last) is a heap.
+    template<size_t D, class RandomAccessIterator, class Compare>
+    bool is_dary_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance len = last - first;
+        for (Distance i = 1; i < len; ++i) {
+            if (comp(*(first + (i - 1) / Distance(D)), *(first + i)))
+                return false;
+        }
+        return true;
+    }
+
+    //Binary heap.
+    template<class RandomAccessIterator, class Compare>
+    void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        push_dary_heap<2>(first, last, comp);
+    }
+    template<class RandomAccessIterator>
+    void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        push_dary_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+    template<class RandomAccessIterator, class Compare>
+    void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        pop_dary_heap<2>(first, last, comp);
+    }
+    template<class RandomAccessIterator>
+    void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        pop_dary_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+    template<class RandomAccessIterator, class Compare>
+    void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        make_dary_heap<2>(first, last, comp);
+    }
+    template<class RandomAccessIterator>
+    void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        make_dary_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+    template<class RandomAccessIterator, class Compare>
+    void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        sort_dary_heap<2>(first, last, comp);
+    }
+    template<class RandomAccessIterator>
+    void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        sort_dary_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+    template<class RandomAccessIterator, class Compare>
+    bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        return is_dary_heap<2>(first, last, comp);
+    }
+    template<class RandomAccessIterator>
+    bool is_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        return is_dary_heap<2>(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+}
+
+#endif
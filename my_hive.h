@@ -0,0 +1,429 @@
+#ifndef MY_HIVE_H
+#define MY_HIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "my_memory"
+#include "my_algobase.h"
+#include "my_iterator.h"
+#include "my_type_traits.h"
+
+namespace mystl {
+
+    //Unordered container with stable element addresses.
+    //Elements live in blocks that grow geometrically, up to 65535 slots.
+    //An erased slot is destroyed in place and its memory is kept for the next
+    //insert. Iteration jumps over runs of erased slots with a skip field:
+    //both ends of a run hold its length, so ++ and -- are O(1) and
+    //insert and erase are O(1).
+    //Each block keeps a doubly linked list of the starts of its erased runs,
+    //stored inside the erased slots themselves.
+    template<class T, class Alloc = allocator<T> >
+    class hive {
+    public:
+        typedef Alloc allocator_type;
+        typedef T value_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef uint16_t skip_type;
+
+        static const size_type min_block_capacity = 8;
+        static const size_type max_block_capacity = 65535;
+    private:
+        static const skip_type no_slot = 0xFFFF;
+
+        //Links of an erased run, kept in the bytes of its first slot.
+        class free_links {
+        public:
+            skip_type prev;
+            skip_type next;
+        };
+        //Storage for one element, big enough to hold free_links when erased.
+        class slot {
+        public:
+            alignas(T) unsigned char bytes[sizeof(T) < sizeof(free_links) ? sizeof(free_links) : sizeof(T)];
+        };
+        class block {
+        public:
+            slot* slots;
+            //capacity + 1 entries, the last one stays 0 and stops iteration.
+            skip_type* skip;
+            size_type capacity;
+            //Slots [0, last) have been used.
+            size_type last;
+            size_type size;
+            //First erased run, no_slot if none.
+            skip_type free_head;
+            block* next;
+            block* prev;
+            //Chain of blocks with erased runs.
+            block* next_free;
+            block* prev_free;
+
+            pointer value(size_type i) {
+                return reinterpret_cast<pointer>(slots[i].bytes);
+            }
+            free_links links(size_type i) const {
+                free_links l;
+                memcpy(&l, slots[i].bytes, sizeof(l));
+                return l;
+            }
+            void set_links(size_type i, skip_type prev, skip_type next) {
+                free_links l;
+                l.prev = prev;
+                l.next = next;
+                memcpy(slots[i].bytes, &l, sizeof(l));
+            }
+        };
+    public:
+        //Iterator implement.
+        template<class Ref, class Ptr>
+        class hive_iterator: public mystl::iterator<bidirectional_iterator_tag, T, ptrdiff_t, Ptr, Ref> {
+        public:
+            hive_iterator(): _b(0), _i(0) {}
+            hive_iterator(block* b, size_type i): _b(b), _i(i) {}
+            template<class R, class P>
+            hive_iterator(const hive_iterator<R, P>& x): _b(x._b), _i(x._i) {}
+
+            bool operator==(const hive_iterator& x) const {
+                return _b == x._b && _i == x._i;
+            }
+            bool operator!=(const hive_iterator& x) const {
+                return !(*this == x);
+            }
+            Ref operator*() const {
+                return *_b->value(_i);
+            }
+            Ptr operator->() const {
+                return _b->value(_i);
+            }
+            hive_iterator& operator++() {
+                ++_i;
+                _i += _b->skip[_i];
+                if (_i == _b->last && 0 != _b->next) {
+                    _b = _b->next;
+                    _i = _b->skip[0];
+                }
+                return *this;
+            }
+            hive_iterator operator++(int) {
+                hive_iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            hive_iterator& operator--() {
+                for ( ; ; ) {
+                    if (_i == 0) {
+                        _b = _b->prev;
+                        _i = _b->last;
+                    }
+                    --_i;
+                    if (_b->skip[_i] == 0)
+                        break;
+                    //End of an erased run, jump to its start.
+                    _i = _i + 1 - _b->skip[_i];
+                }
+                return *this;
+            }
+            hive_iterator operator--(int) {
+                hive_iterator temp(*this);
+                --*this;
+                return temp;
+            }
+            template<class R, class P>
+            friend class hive_iterator;
+            friend class hive;
+        private:
+            block* _b;
+            size_type _i;
+        };
+        typedef hive_iterator<T&, T*> iterator;
+        typedef hive_iterator<const T&, const T*> const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        //Constructors.
+        explicit hive(const allocator_type& alloc = allocator_type()):
+            _head(0), _tail(0), _free_blocks(0), _size(0), _next_capacity(min_block_capacity),
+            _allocator(alloc) {}
+        hive(const hive& x): _head(0), _tail(0), _free_blocks(0), _size(0),
+            _next_capacity(min_block_capacity), _allocator(x._allocator) {
+            for (const_iterator i = x.begin(); i != x.end(); ++i)
+                insert(*i);
+        }
+        hive(hive&& x): _head(0), _tail(0), _free_blocks(0), _size(0),
+            _next_capacity(min_block_capacity), _allocator(x._allocator) {
+            swap(x);
+        }
+        //Destructor.
+        ~hive() {
+            clear();
+        }
+
+        hive& operator=(const hive& x) {
+            if (this != &x) {
+                hive temp(x);
+                swap(temp);
+            }
+            return *this;
+        }
+        hive& operator=(hive&& x) {
+            if (this != &x) {
+                clear();
+                swap(x);
+            }
+            return *this;
+        }
+
+        //Data access.
+        iterator begin() {
+            return _head ? iterator(_head, _head->skip[0]) : iterator();
+        }
+        const_iterator begin() const {
+            return _head ? const_iterator(_head, _head->skip[0]) : const_iterator();
+        }
+        iterator end() {
+            return _tail ? iterator(_tail, _tail->last) : iterator();
+        }
+        const_iterator end() const {
+            return _tail ? const_iterator(_tail, _tail->last) : const_iterator();
+        }
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        size_type size() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        //Slots held by all blocks.
+        size_type capacity() const {
+            size_type n = 0;
+            for (block* b = _head; b; b = b->next)
+                n += b->capacity;
+            return n;
+        }
+
+        //Operations.
+        //Insert value, reusing an erased slot if there is one.
+        iterator insert(const value_type& value) {
+            return emplace(value);
+        }
+        iterator insert(value_type&& value) {
+            return emplace(mystl::move(value));
+        }
+        template<class... Args>
+        iterator emplace(Args&&... args) {
+            if (0 != _free_blocks) {
+                block* b = _free_blocks;
+                size_type i = take_free_slot(b);
+                try {
+                    new(b->value(i)) value_type(mystl::forward<Args>(args)...);
+                } catch (...) {
+                    mark_erased(b, i);
+                    throw;
+                }
+                ++b->size;
+                ++_size;
+                return iterator(b, i);
+            }
+            if (0 == _tail || _tail->last == _tail->capacity)
+                append_block();
+            block* b = _tail;
+            size_type i = b->last;
+            new(b->value(i)) value_type(mystl::forward<Args>(args)...);
+            ++b->last;
+            ++b->size;
+            ++_size;
+            return iterator(b, i);
+        }
+        //Erase element of position, return the next one.
+        iterator erase(const_iterator position) {
+            block* b = position._b;
+            size_type i = position._i;
+            iterator next(b, i);
+            ++next;
+            bool at_end = next == end();
+            _allocator.destroy(b->value(i));
+            --_size;
+            if (--b->size == 0) {
+                free_block(b);
+            } else {
+                mark_erased(b, i);
+            }
+            return at_end ? end() : next;
+        }
+        void clear() {
+            while (0 != _head) {
+                for (iterator i(_head, _head->skip[0]); i._b == _head && i._i != _head->last; ++i)
+                    _allocator.destroy(&*i);
+                _head->size = 0;
+                free_block(_head);
+            }
+            _size = 0;
+            _next_capacity = min_block_capacity;
+        }
+        void swap(hive& x) {
+            mystl::swap(_head, x._head);
+            mystl::swap(_tail, x._tail);
+            mystl::swap(_free_blocks, x._free_blocks);
+            mystl::swap(_size, x._size);
+            mystl::swap(_next_capacity, x._next_capacity);
+        }
+    private:
+        block* _head;
+        block* _tail;
+        block* _free_blocks;
+        size_type _size;
+        size_type _next_capacity;
+        allocator_type _allocator;
+        allocator<block> block_allocator;
+        allocator<slot> slot_allocator;
+        allocator<skip_type> skip_allocator;
+
+        void append_block() {
+            size_type n = _next_capacity;
+            block* b = block_allocator.allocate(1);
+            b->slots = slot_allocator.allocate(n);
+            b->skip = skip_allocator.allocate(n + 1);
+            memset(b->skip, 0, (n + 1) * sizeof(skip_type));
+            b->capacity = n;
+            b->last = 0;
+            b->size = 0;
+            b->free_head = no_slot;
+            b->next = 0;
+            b->prev = _tail;
+            b->next_free = 0;
+            b->prev_free = 0;
+            if (_tail)
+                _tail->next = b;
+            else
+                _head = b;
+            _tail = b;
+            if (_next_capacity < max_block_capacity)
+                _next_capacity = _next_capacity * 2 < max_block_capacity ? _next_capacity * 2 : max_block_capacity;
+        }
+        void free_block(block* b) {
+            if (b->free_head != no_slot)
+                unlink_free_block(b);
+            if (b->prev)
+                b->prev->next = b->next;
+            else
+                _head = b->next;
+            if (b->next)
+                b->next->prev = b->prev;
+            else
+                _tail = b->prev;
+            skip_allocator.deallocate(b->skip, b->capacity + 1);
+            slot_allocator.deallocate(b->slots, b->capacity);
+            block_allocator.deallocate(b, 1);
+        }
+        void link_free_block(block* b) {
+            b->prev_free = 0;
+            b->next_free = _free_blocks;
+            if (_free_blocks)
+                _free_blocks->prev_free = b;
+            _free_blocks = b;
+        }
+        void unlink_free_block(block* b) {
+            if (b->prev_free)
+                b->prev_free->next_free = b->next_free;
+            else
+                _free_blocks = b->next_free;
+            if (b->next_free)
+                b->next_free->prev_free = b->prev_free;
+        }
+        //Put run start s into the free list of b.
+        void push_run(block* b, size_type s) {
+            if (b->free_head == no_slot)
+                link_free_block(b);
+            else
+                b->set_links(b->free_head, (skip_type)s, b->links(b->free_head).next);
+            b->set_links(s, no_slot, b->free_head);
+            b->free_head = (skip_type)s;
+        }
+        //Take run start s out of the free list of b.
+        void pop_run(block* b, size_type s) {
+            free_links l = b->links(s);
+            if (l.prev != no_slot)
+                b->set_links(l.prev, b->links(l.prev).prev, l.next);
+            else
+                b->free_head = l.next;
+            if (l.next != no_slot)
+                b->set_links(l.next, l.prev, b->links(l.next).next);
+            if (b->free_head == no_slot)
+                unlink_free_block(b);
+        }
+        //Run start moves from s to t, keeping its place in the free list.
+        void move_run(block* b, size_type s, size_type t) {
+            free_links l = b->links(s);
+            b->set_links(t, l.prev, l.next);
+            if (l.prev != no_slot)
+                b->set_links(l.prev, b->links(l.prev).prev, (skip_type)t);
+            else
+                b->free_head = (skip_type)t;
+            if (l.next != no_slot)
+                b->set_links(l.next, (skip_type)t, b->links(l.next).next);
+        }
+        //Take the first slot of the first erased run of b. Its links are read
+        //here, before the new element overwrites them.
+        size_type take_free_slot(block* b) {
+            size_type s = b->free_head;
+            size_type len = b->skip[s];
+            if (len > 1) {
+                move_run(b, s, s + 1);
+                b->skip[s + 1] = (skip_type)(len - 1);
+                b->skip[s + len - 1] = (skip_type)(len - 1);
+            } else {
+                pop_run(b, s);
+            }
+            b->skip[s] = 0;
+            return s;
+        }
+        //Update skip field and free list after slot i of b was destroyed.
+        void mark_erased(block* b, size_type i) {
+            size_type left = i > 0 ? b->skip[i - 1] : 0;
+            size_type right = b->skip[i + 1];
+            if (left == 0 && right == 0) {
+                b->skip[i] = 1;
+                push_run(b, i);
+            } else if (right == 0) {
+                size_type len = left + 1;
+                b->skip[i - left] = (skip_type)len;
+                b->skip[i] = (skip_type)len;
+            } else if (left == 0) {
+                size_type len = right + 1;
+                b->skip[i] = (skip_type)len;
+                b->skip[i + right] = (skip_type)len;
+                move_run(b, i + 1, i);
+            } else {
+                size_type len = left + right + 1;
+                pop_run(b, i + 1);
+                b->skip[i - left] = (skip_type)len;
+                b->skip[i + right] = (skip_type)len;
+            }
+        }
+    };
+
+    template<class T, class Alloc>
+    void swap(hive<T, Alloc>& l, hive<T, Alloc>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
@@ -0,0 +1,322 @@
+#ifndef MY_INDEX_LIST_H
+#define MY_INDEX_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdexcept>
+#include "my_vector.h"
+#include "my_iterator.h"
+#include "my_type_traits.h"
+
+namespace mystl {
+
+    //Index list node, linked by 32-bit positions in the node array.
+    template<class T>
+    class index_node {
+    public:
+        T val;
+        uint32_t next;
+        uint32_t prev;
+    };
+
+    //Doubly linked list whose nodes live in one vector and link through
+    //32-bit indices. A node costs sizeof(T) + 8 bytes instead of two pointers
+    //plus a heap block, and nodes stay close together.
+    //The whole state is the node array, so it can be moved or written out
+    //with one memcpy of data() and read back with assign_nodes.
+    //Node 0 is the sentinel of the list, node 1 heads the chain of free nodes.
+    //Unlike list, insert places the new element before position.
+    template<typename T>
+    class index_list {
+        static_assert(is_trivially_copyable<T>::value, "index_list relocates nodes as raw bytes");
+    public:
+        typedef T value_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef uint32_t index_type;
+        typedef index_node<T> node_type;
+
+        //Iterator implement. Holds an index, so it survives growth of the node array.
+        template<class Nodes, class Ref, class Ptr>
+        class list_iterator: public mystl::iterator<bidirectional_iterator_tag, T, ptrdiff_t, Ptr, Ref> {
+        public:
+            list_iterator(): _nodes(0), _i(0) {}
+            list_iterator(Nodes* nodes, index_type i): _nodes(nodes), _i(i) {}
+            //iterator converts to const_iterator.
+            template<class N, class R, class P>
+            list_iterator(const list_iterator<N, R, P>& x): _nodes(x._nodes), _i(x._i) {}
+
+            bool operator==(const list_iterator& x) const {
+                return _i == x._i;
+            }
+            bool operator!=(const list_iterator& x) const {
+                return _i != x._i;
+            }
+            Ref operator*() const {
+                return (*_nodes)[_i].val;
+            }
+            Ptr operator->() const {
+                return &(*_nodes)[_i].val;
+            }
+            list_iterator& operator++() {
+                _i = (*_nodes)[_i].next;
+                return *this;
+            }
+            list_iterator operator++(int) {
+                list_iterator temp(*this);
+                _i = (*_nodes)[_i].next;
+                return temp;
+            }
+            list_iterator& operator--() {
+                _i = (*_nodes)[_i].prev;
+                return *this;
+            }
+            list_iterator operator--(int) {
+                list_iterator temp(*this);
+                _i = (*_nodes)[_i].prev;
+                return temp;
+            }
+            //Position of the node in the node array.
+            index_type index() const {
+                return _i;
+            }
+            template<class N, class R, class P>
+            friend class list_iterator;
+            friend class index_list;
+        private:
+            Nodes* _nodes;
+            index_type _i;
+        };
+        typedef list_iterator<vector<node_type>, T&, T*> iterator;
+        typedef list_iterator<const vector<node_type>, const T&, const T*> const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        //Constructors.
+        index_list(): _size(0) {
+            init();
+        }
+        explicit index_list(size_type n, const value_type& val = value_type()): _size(0) {
+            init();
+            insert(end(), n, val);
+        }
+        template<class InputIterator>
+        index_list(InputIterator first, InputIterator last,
+                typename enable_if<!is_integral<InputIterator>::value>::type* = 0): _size(0) {
+            init();
+            insert(end(), first, last);
+        }
+
+        //Data access.
+        iterator begin() {
+            return iterator(&_nodes, _nodes[0].next);
+        }
+        const_iterator begin() const {
+            return const_iterator(&_nodes, _nodes[0].next);
+        }
+        iterator end() {
+            return iterator(&_nodes, 0);
+        }
+        const_iterator end() const {
+            return const_iterator(&_nodes, 0);
+        }
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        size_type size() const {
+            return _size;
+        }
+        size_type max_size() const {
+            return (size_type)(index_type)-1 - 2;
+        }
+        reference front() {
+            return _nodes[_nodes[0].next].val;
+        }
+        const_reference front() const {
+            return _nodes[_nodes[0].next].val;
+        }
+        reference back() {
+            return _nodes[_nodes[0].prev].val;
+        }
+        const_reference back() const {
+            return _nodes[_nodes[0].prev].val;
+        }
+
+        //Raw node storage, sentinels and free nodes included.
+        const node_type* data() const {
+            return _nodes.begin();
+        }
+        size_type node_count() const {
+            return _nodes.size();
+        }
+        //Rebuild from n nodes copied out of data() of another index_list.
+        void assign_nodes(const node_type* p, size_type n) {
+            _nodes.assign_from_raw(p, n);
+            _size = 0;
+            for (index_type i = _nodes[0].next; i != 0; i = _nodes[i].next)
+                ++_size;
+        }
+        //Make room for n elements without growing the node array again.
+        void reserve(size_type n) {
+            _nodes.reserve(n + 2);
+        }
+
+        //Operations.
+        void push_front(const value_type& value) {
+            insert(begin(), value);
+        }
+        void pop_front() {
+            erase(begin());
+        }
+        void push_back(const value_type& value) {
+            insert(end(), value);
+        }
+        void pop_back() {
+            erase(iterator(&_nodes, _nodes[0].prev));
+        }
+        //Insert value before position.
+        iterator insert(iterator position, const value_type& value) {
+            index_type i = alloc_node();
+            _nodes[i].val = value;
+            link_before(position._i, i, i);
+            ++_size;
+            return iterator(&_nodes, i);
+        }
+        iterator insert(iterator position, size_type n, const value_type& value) {
+            for ( ; n > 0; --n)
+                position = insert(position, value);
+            return position;
+        }
+        template<class InputIterator>
+        void insert(iterator position, InputIterator first, InputIterator last,
+                typename enable_if<!is_integral<InputIterator>::value>::type* = 0) {
+            for ( ; first != last; ++first)
+                insert(position, *first);
+        }
+        template<class InputIterator>
+        void assign(InputIterator first, InputIterator last) {
+            clear();
+            insert(end(), first, last);
+        }
+        //Erase node of position, return the next one.
+        iterator erase(iterator position) {
+            index_type i = position._i;
+            index_type next = _nodes[i].next;
+            unlink(i, i);
+            dealloc_node(i);
+            --_size;
+            return iterator(&_nodes, next);
+        }
+        iterator erase(iterator first, iterator last) {
+            while (first != last)
+                first = erase(first);
+            return last;
+        }
+        //Clear contents, the node array keeps its capacity.
+        void clear() {
+            _nodes.resize(2);
+            init_links();
+            _size = 0;
+        }
+        void swap(index_list& x) {
+            _nodes.swap(x._nodes);
+            mystl::swap(_size, x._size);
+        }
+        //Move [first, last) before position in O(1). All three iterators must
+        //come from this list, and position must not be in [first, last).
+        void splice(iterator position, iterator first, iterator last) {
+            if (first == last || position == first || position == last)
+                return;
+            index_type f = first._i;
+            index_type l = _nodes[last._i].prev;
+            unlink(f, l);
+            link_before(position._i, f, l);
+        }
+        //Move the element at i before position in O(1).
+        void splice(iterator position, iterator i) {
+            iterator j = i;
+            ++j;
+            if (position == i || position == j)
+                return;
+            splice(position, i, j);
+        }
+        void remove(const value_type& value) {
+            for (iterator i = begin(); i != end(); ) {
+                if (*i == value)
+                    i = erase(i);
+                else
+                    ++i;
+            }
+        }
+    private:
+        static const index_type free_head = 1;
+
+        vector<node_type> _nodes;
+        size_type _size;
+
+        void init() {
+            _nodes.resize_default_init(2);
+            init_links();
+        }
+        void init_links() {
+            _nodes[0].next = 0;
+            _nodes[0].prev = 0;
+            _nodes[free_head].next = free_head;
+            _nodes[free_head].prev = free_head;
+        }
+        index_type alloc_node() {
+            index_type i = _nodes[free_head].next;
+            if (i != free_head) {
+                _nodes[free_head].next = _nodes[i].next;
+                return i;
+            }
+            if (_nodes.size() >= (size_type)(index_type)-1)
+                throw std::length_error("my_index_list too many nodes");
+            i = (index_type)_nodes.size();
+            _nodes.resize_default_init(_nodes.size() + 1);
+            return i;
+        }
+        void dealloc_node(index_type i) {
+            _nodes[i].next = _nodes[free_head].next;
+            _nodes[free_head].next = i;
+        }
+        //Link the chain f..l in before node p.
+        void link_before(index_type p, index_type f, index_type l) {
+            index_type prev = _nodes[p].prev;
+            _nodes[prev].next = f;
+            _nodes[f].prev = prev;
+            _nodes[l].next = p;
+            _nodes[p].prev = l;
+        }
+        //Cut the chain f..l out of the list.
+        void unlink(index_type f, index_type l) {
+            index_type prev = _nodes[f].prev;
+            index_type next = _nodes[l].next;
+            _nodes[prev].next = next;
+            _nodes[next].prev = prev;
+        }
+    };
+
+    template<class T>
+    void swap(index_list<T>& l, index_list<T>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
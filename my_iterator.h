@@ -2,7 +2,9 @@
 #define MY_ITERATOR_H
 
 #include <stddef.h>
-#include "my_algobase.h"
+#include <iterator>
+#include "my_construct.h"
+#include "my_type_traits.h"
 
 namespace mystl {
 
@@ -12,6 +14,8 @@ namespace mystl {
     class forward_iterator_tag: public input_iterator_tag{};
     class bidirectional_iterator_tag: public forward_iterator_tag {};
     class random_access_iterator_tag: public bidirectional_iterator_tag {};
+    //Elements are adjacent in memory, so ranges can be handled as raw bytes.
+    class contiguous_iterator_tag: public random_access_iterator_tag {};
 
     //A base iterator class for containers.
     template<class Category, class T, class Distance = ptrdiff_t, class Pointer = T*, class Reference = T&>
@@ -25,11 +29,44 @@ namespace mystl {
         
     };
 
+    //Tags of standard library iterators, e.g. std::istream_iterator, map to
+    //ours so their ranges take the matching dispatch paths.
+    template<class Category>
+    class _std_category {
+    public:
+        typedef Category type;
+    };
+    template<>
+    class _std_category<std::input_iterator_tag> {
+    public:
+        typedef input_iterator_tag type;
+    };
+    template<>
+    class _std_category<std::output_iterator_tag> {
+    public:
+        typedef output_iterator_tag type;
+    };
+    template<>
+    class _std_category<std::forward_iterator_tag> {
+    public:
+        typedef forward_iterator_tag type;
+    };
+    template<>
+    class _std_category<std::bidirectional_iterator_tag> {
+    public:
+        typedef bidirectional_iterator_tag type;
+    };
+    template<>
+    class _std_category<std::random_access_iterator_tag> {
+    public:
+        typedef random_access_iterator_tag type;
+    };
+
     //For traits.
     template<class Iterator>
     class iterator_traits {
     public:
-        typedef typename Iterator::iterator_category iterator_category;
+        typedef typename _std_category<typename Iterator::iterator_category>::type iterator_category;
         typedef typename Iterator::value_type value_type;
         typedef typename Iterator::difference_type difference_type;
         typedef typename Iterator::pointer pointer;
@@ -40,7 +77,7 @@ namespace mystl {
     template<class T>
     class iterator_traits<T*> {
     public:
-        typedef random_access_iterator_tag iterator_category;
+        typedef contiguous_iterator_tag iterator_category;
         typedef T value_type;
         typedef ptrdiff_t difference_type;
         typedef T* pointer;
@@ -51,7 +88,7 @@ namespace mystl {
     template<class T>
     class iterator_traits<const T*> {
     public:
-        typedef random_access_iterator_tag iterator_category;
+        typedef contiguous_iterator_tag iterator_category;
         //In my opinion, value_type should be const T.
         typedef const T value_type;
         typedef ptrdiff_t difference_type;
@@ -59,15 +96,40 @@ namespace mystl {
         typedef const T& reference;
     };
 
+    //Check if iterator is contiguous.
+    template<class Iterator>
+    class is_contiguous_iterator: public integral_constant<bool,
+            is_same<typename iterator_traits<Iterator>::iterator_category, contiguous_iterator_tag>::value> {};
+
+    //Address of the element a contiguous iterator points to.
+    template<class T>
+    T* _to_address(T* p) {
+        return p;
+    }
+
+    //Reversing a contiguous range walks memory backward, so it is only random access.
+    template<class Category>
+    class _reverse_category {
+    public:
+        typedef Category type;
+    };
+    template<>
+    class _reverse_category<contiguous_iterator_tag> {
+    public:
+        typedef random_access_iterator_tag type;
+    };
+
     //A base reverse_iterator class for containers.
     template<class Iterator>
-    class reverse_iterator: public iterator<typename iterator_traits<Iterator>::iterator_category,
+    class reverse_iterator: public iterator<typename _reverse_category<
+            typename iterator_traits<Iterator>::iterator_category>::type,
             typename iterator_traits<Iterator>::value_type,
             typename iterator_traits<Iterator>::difference_type,
             typename iterator_traits<Iterator>::pointer,
             typename iterator_traits<Iterator>::reference > {
     public:
-        typedef typename iterator_traits<Iterator>::iterator_category iterator_category;
+        typedef typename _reverse_category<
+                typename iterator_traits<Iterator>::iterator_category>::type iterator_category;
         typedef typename iterator_traits<Iterator>::value_type value_type;
         typedef typename iterator_traits<Iterator>::difference_type difference_type;
         typedef typename iterator_traits<Iterator>::pointer pointer;
@@ -77,12 +139,13 @@ namespace mystl {
         reverse_iterator() {}
         explicit reverse_iterator(Iterator it): current(it) {}
         template<class U>
-        reverse_iterator(const reverse_iterator<U>& it): current(it){}
+        reverse_iterator(const reverse_iterator<U>& it): current(it.base()) {}
 
         //Assign
         template<class U>
         reverse_iterator& operator=(const reverse_iterator<U>& it) {
-            current = it.current;
+            current = it.base();
+            return *this;
         }
 
         //Return base iterator.
@@ -149,7 +212,7 @@ namespace mystl {
     template<class RandomAccessIterator>
     inline typename iterator_traits<RandomAccessIterator>::difference_type
     _distance(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
-        return first - last;
+        return last - first;
     }
     //Distance for general.
     template<class Iterator>
@@ -186,6 +249,13 @@ namespace mystl {
         _advance(it, n, typename iterator_traits<Iterator>::iterator_category());
     }
 
+    //Check if iterator is a reverse_iterator over a contiguous range.
+    template<class Iterator>
+    class is_reverse_contiguous_iterator: public false_type {};
+    template<class Iterator>
+    class is_reverse_contiguous_iterator<reverse_iterator<Iterator> >:
+        public is_contiguous_iterator<Iterator> {};
+
     //Functions for reverse_iterator.
     template<class Iterator1, class Iterator2>
     bool operator==(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
@@ -197,19 +267,24 @@ namespace mystl {
     }
     template<class Iterator1, class Iterator2>
     bool operator<(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
-        return l.base() < r.base();
+        return l.base() > r.base();
     }
     template<class Iterator1, class Iterator2>
     bool operator>(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
-        return l.base() > r.base();
+        return l.base() < r.base();
     }
     template<class Iterator1, class Iterator2>
     bool operator<=(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
-        return l.base() <= r.base();
+        return l.base() >= r.base();
     }
     template<class Iterator1, class Iterator2>
     bool operator>=(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
-        return l.base() >= r.base();
+        return l.base() <= r.base();
+    }
+    template<class Iterator1, class Iterator2>
+    typename reverse_iterator<Iterator1>::difference_type
+    operator-(const reverse_iterator<Iterator1>& l, const reverse_iterator<Iterator2>& r) {
+        return r.base() - l.base();
     }
 
 
@@ -1,11 +1,23 @@
 #ifndef MY_LIST_H
 #define MY_LIST_H
 
+#include <atomic>
 #include "my_memory"
 #include "my_algobase.h"
 #include "my_iterator.h"
+#include "my_trace.h"
 
 namespace mystl {
+	//Nodes allocated together, by compact or a range insert. Its nodes may
+	//be spliced into other lists, so the block counts the nodes not given
+	//back yet, and whichever list gives back the last one frees it.
+	class _node_block {
+	public:
+		std::atomic<size_t> live;
+		size_t size;
+		void* first;
+	};
+
 	//List node.
 	template <class T>
 	class node {
@@ -13,8 +25,19 @@ namespace mystl {
 		T val;
 		node* next;
 		node* prev;
+		//Block holding the node, 0 if allocated alone.
+		_node_block* block;
 	};
 
+	//Hint the cache to load p, does nothing where unsupported.
+	inline void _prefetch(const void* p) {
+#if defined(__GNUC__)
+		__builtin_prefetch(p);
+#else
+		(void)p;
+#endif
+	}
+
 	template<typename T, typename Alloc = allocator<T> >
 	class list {
 	public:
@@ -33,7 +56,7 @@ namespace mystl {
 		public:
 			typedef node<T>* link_type;
 
-			iterator() {}
+			iterator(): _node(0) {}
 			iterator(link_type x): _node(x) {}
 			iterator(const iterator& x): _node(x._node) {}
 			iterator& operator=(const iterator& x) {
@@ -82,14 +105,14 @@ namespace mystl {
 		
 		//Constructors.
 		explicit list(const allocator_type& alloc = allocator_type()): 
-			_allocator(alloc) {
+			_allocator(alloc), _free(0) {
 			_node = alloc_node();
 			_node->next = _node;
 			_node->prev = _node;
 		}
 		explicit list(size_type n, const value_type& val = value_type(), 
 				const allocator_type& alloc = allocator_type()):
-			_allocator(alloc) {
+			_allocator(alloc), _free(0) {
 			_node = alloc_node();
 			_node->next = _node;
 			_node->prev = _node;
@@ -98,22 +121,31 @@ namespace mystl {
 		template<class InputIterator>
 		list(InputIterator first, InputIterator last, 
 				const allocator_type& alloc = allocator_type()):
-			_allocator(alloc) {
+			_allocator(alloc), _free(0) {
 			_node = alloc_node();
 			_node->next = _node;
 			_node->prev = _node;
 			insert(end(), first, last);
 		}
+		list(const list& x):
+			_allocator(x._allocator), _free(0) {
+			_node = alloc_node();
+			_node->next = _node;
+			_node->prev = _node;
+			insert(end(), x.begin(), x.end());
+		}
 		//Destructor.
 		~list() {
 			erase(begin(), end());
 			dealloc_node(_node);
+			release_free();
 		}
 
 		//Copy.
 		list& operator=(const list& x) {
 			erase(begin(), end());
 			insert(begin(), x.begin(), x.end());
+			return *this;
 		}
 		
 		//Data access.
@@ -191,6 +223,7 @@ namespace mystl {
 			link_type temp = x._node;
 			x._node = _node;
 			_node = temp;
+			mystl::swap(_free, x._free);
 		}
 		
 		//Resize list.
@@ -222,14 +255,12 @@ namespace mystl {
 			}
 			return position;
 		}
+		//Range insert. The whole node chain is built first and linked in
+		//after position at once, so a throwing copy leaves the list as it was.
+		//Integral arguments mean n copies of a value.
 		template<class InputIterator>
 		void insert(iterator position, InputIterator first, InputIterator last) {
-			iterator temp(position);
-			for ( ; first != last; ++first) {
-				insert(temp, *first);
-				++temp;
-			}
-			return position;
+			insert_dispatch(position, first, last, typename is_integral<InputIterator>::type());
 		}
 
 		//Erase node of position.
@@ -244,33 +275,33 @@ namespace mystl {
 		iterator erase(iterator first, iterator last) {
 			while (first != last)
 				first = erase(first);
+			return last;
 		}
 
 		//Clear contents.
 		void clear() {
 			erase(begin(), end());
 		}
-		//Splice objects from other list to position.
+		//Splice objects from other list to after position.
+		//Nodes are unlinked from where they were first, so this also moves
+		//nodes inside one list, e.g. an element to the front in O(1).
+		//Nodes change owner as they are, so iterators stay valid and nothing
+		//is allocated or copied, even for nodes from a block of x.
 		void splice(iterator position, list& x) {
 			splice(position, x, x.begin(), x.end());
 		}
 		void splice(iterator position, list& x, iterator i) {
-			if (i == x.end())
+			if (i == x.end() || position == i)
 				return;
-			link_type temp = position._node->next;
-			position._node->next = i._node;
-			i._node->prev = position._node;
-			i._node->next = temp;
-			temp->prev = i._node;
+			unlink(i._node, i._node);
+			link_after(position._node, i._node, i._node);
 		}
-		void splice(iterator position, list& x, iterator first, iterator last) {
-			link_type temp = position._node->next;
-			position._node->next = first._node;
-			first._node->prev = position._node;
-			iterator de = last;
-			--de;
-			de._node->next = temp;
-			temp->prev = de._node;
+		void splice(iterator position, list&, iterator first, iterator last) {
+			if (first == last)
+				return;
+			link_type l = last._node->prev;
+			unlink(first._node, l);
+			link_after(position._node, first._node, l);
 		}
 		void remove(const value_type& value) {
 			for (iterator i = begin(); i != end(); ++i) {
@@ -283,18 +314,227 @@ namespace mystl {
 			}
 		}
 
+		//Move all nodes into one contiguous block, in iteration order.
+		//After long churn nodes are scattered over the heap and every ++ is a
+		//cache miss. Compacting makes a scan walk memory forward. Values are
+		//moved into the new nodes, iterators and pointers to elements are invalidated.
+		//Recycled nodes are given back too.
+		void compact() {
+			size_type n = size();
+			if (n > 0) {
+				link_type block = alloc_block(n);
+				link_type prev = _node;
+				link_type cur = _node->next;
+				for (size_type i = 0; i < n; ++i) {
+					link_type next = cur->next;
+					link_type it = block + i;
+					new(&it->val) value_type(mystl::move(cur->val));
+					_allocator.destroy(&cur->val);
+					release_node(cur);
+					prev->next = it;
+					it->prev = prev;
+					prev = it;
+					cur = next;
+				}
+				prev->next = _node;
+				_node->prev = prev;
+			}
+			release_free();
+		}
+		//Call f on every element, prefetching the node distance steps ahead so
+		//the memory latency of the walk overlaps with the work of f.
+		template<class Function>
+		Function for_each_prefetch(Function f, size_type distance = 8) {
+			link_type ahead = _node->next;
+			for (size_type i = 0; i < distance && ahead != _node; ++i)
+				ahead = ahead->next;
+			for (link_type cur = _node->next; cur != _node; cur = cur->next) {
+				if (ahead != _node) {
+					_prefetch(ahead->next);
+					ahead = ahead->next;
+				}
+				f(cur->val);
+			}
+			return f;
+		}
+
 		//Remain unique, sort, merge, reverse unfinished.
 		private:
 			//A pointer to a node without value.
 			link_type _node;
 			allocator_type _allocator;
 			allocator<node_type> node_allocator;
+			//Nodes of blocks given back by erase, chained through next for
+			//reuse. They stay counted as live in their blocks until released.
+			link_type _free;
+			allocator<_node_block> block_allocator;
 
+			//Range inserts needing fewer new nodes allocate them one by one.
+			static const size_type min_batch = 16;
+
+			//Allocate n nodes as one block and chain them through next.
+			link_type alloc_block(size_type n) {
+				trace_scope<trace_policy> trace(trace_node_alloc, n * sizeof(node_type),
+						_trace_wanted<trace_policy>(n * sizeof(node_type)));
+				_node_block* b = block_allocator.allocate(1);
+				link_type first;
+				try {
+					first = node_allocator.allocate(n);
+				} catch (...) {
+					block_allocator.deallocate(b, 1);
+					throw;
+				}
+				new(&b->live) std::atomic<size_t>(n);
+				b->size = n;
+				b->first = first;
+				for (size_type k = 0; k < n; ++k) {
+					first[k].block = b;
+					first[k].next = first + k + 1;
+				}
+				first[n - 1].next = 0;
+				return first;
+			}
+			//Give a node back for good, freeing its block with its last node.
+			//The count is atomic as lists sharing a block may live in
+			//different threads.
+			void release_node(link_type n) {
+				_node_block* b = n->block;
+				if (0 == b) {
+					node_allocator.deallocate(n, 1);
+				} else if (b->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					node_allocator.deallocate(static_cast<link_type>(b->first), b->size);
+					b->live.~atomic();
+					block_allocator.deallocate(b, 1);
+				}
+			}
+			void release_free() {
+				while (0 != _free) {
+					link_type n = _free;
+					_free = n->next;
+					release_node(n);
+				}
+			}
+			//Cut the chain f..l out of the list.
+			static void unlink(link_type f, link_type l) {
+				f->prev->next = l->next;
+				l->next->prev = f->prev;
+			}
+			//Link the chain f..l in after node p.
+			static void link_after(link_type p, link_type f, link_type l) {
+				link_type next = p->next;
+				p->next = f;
+				f->prev = p;
+				l->next = next;
+				next->prev = l;
+			}
+			template<class Integer>
+			void insert_dispatch(iterator position, Integer n, Integer value, true_type) {
+				insert(position, (size_type)n, (value_type)value);
+			}
+			template<class InputIterator>
+			void insert_dispatch(iterator position, InputIterator first, InputIterator last, false_type) {
+				range_insert(position, first, last, typename iterator_traits<InputIterator>::iterator_category());
+			}
+			//Input ranges can not be counted, their nodes come one by one.
+			template<class InputIterator>
+			void range_insert(iterator position, InputIterator first, InputIterator last, input_iterator_tag) {
+				if (first == last)
+					return;
+				link_type f = make_node(*first);
+				link_type l = f;
+				try {
+					for (++first; first != last; ++first) {
+						link_type n = make_node(*first);
+						l->next = n;
+						n->prev = l;
+						l = n;
+					}
+				} catch (...) {
+					destroy_chain(f, l);
+					throw;
+				}
+				link_after(position._node, f, l);
+			}
+			//Forward ranges take recycled nodes first, then allocate the rest
+			//as one block when there are at least min_batch of them.
+			template<class ForwardIterator>
+			void range_insert(iterator position, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+				size_type n = mystl::distance(first, last);
+				if (n == 0)
+					return;
+				size_type recycled = 0;
+				for (link_type p = _free; 0 != p && recycled < n; p = p->next)
+					++recycled;
+				if (n - recycled >= min_batch) {
+					//Put the new block behind the free nodes, so both are used.
+					link_type block = alloc_block(n - recycled);
+					if (0 == _free) {
+						_free = block;
+					} else {
+						link_type tail = _free;
+						while (0 != tail->next)
+							tail = tail->next;
+						tail->next = block;
+					}
+				}
+				link_type f = make_node(*first);
+				link_type l = f;
+				try {
+					for (++first; first != last; ++first) {
+						link_type node = make_node(*first);
+						l->next = node;
+						node->prev = l;
+						l = node;
+					}
+				} catch (...) {
+					destroy_chain(f, l);
+					throw;
+				}
+				link_after(position._node, f, l);
+			}
+			void destroy_chain(link_type f, link_type l) {
+				for (link_type n = f; ; ) {
+					link_type next = n->next;
+					destroy_node(n);
+					if (n == l)
+						break;
+					n = next;
+				}
+			}
+			link_type make_node(const value_type& value) {
+				link_type n = alloc_node();
+				try {
+					_allocator.construct(&(n->val), value);
+				} catch (...) {
+					dealloc_node(n);
+					throw;
+				}
+				return n;
+			}
+			void destroy_node(link_type n) {
+				_allocator.destroy(&(n->val));
+				dealloc_node(n);
+			}
 			link_type alloc_node() {
-				return node_allocator.allocate(1);
+				if (0 != _free) {
+					link_type n = _free;
+					_free = n->next;
+					return n;
+				}
+				trace_scope<trace_policy> trace(trace_node_alloc, sizeof(node_type),
+						_trace_wanted<trace_policy>(sizeof(node_type)));
+				link_type n = node_allocator.allocate(1);
+				n->block = 0;
+				return n;
 			}
+			//Block nodes are kept for reuse, others are freed at once.
 			void dealloc_node(link_type n) {
-				return node_allocator.deallocate(n, 1);
+				if (0 != n->block) {
+					n->next = _free;
+					_free = n;
+					return;
+				}
+				node_allocator.deallocate(n, 1);
 			}
 		
 	};
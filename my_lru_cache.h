@@ -0,0 +1,561 @@
+#ifndef MY_LRU_CACHE_H
+#define MY_LRU_CACHE_H
+
+#include <stddef.h>
+#include <mutex>
+#include "my_memory"
+#include "my_function.h"
+#include "my_list.h"
+#include "my_vector.h"
+
+namespace mystl {
+
+    //Open addressing index from a key hash to Ref, the place of the entry in
+    //its cache. Linear probing, at most half full, and erase shifts later
+    //entries back instead of leaving tombstones, so probes stay short under churn.
+    //Caches look entries up with a match functor, the index never sees keys.
+    template<class Ref>
+    class _cache_index {
+    public:
+        typedef size_t size_type;
+
+        static const size_type npos = (size_type)-1;
+
+        _cache_index(): _mask(0), _size(0) {}
+
+        //Make room for n entries without growing again.
+        void reserve(size_type n) {
+            size_type cap = 8;
+            while (cap < 2 * n)
+                cap *= 2;
+            if (cap > _slots.size())
+                rehash(cap);
+        }
+        size_type size() const {
+            return _size;
+        }
+        //Slot of the entry with hash h for which match(ref) holds, npos if none.
+        template<class Match>
+        size_type find(size_t h, Match match) const {
+            if (_size == 0)
+                return npos;
+            h = tag(h);
+            for (size_type i = h & _mask; ; i = (i + 1) & _mask) {
+                if (_slots[i].hash == 0)
+                    return npos;
+                if (_slots[i].hash == h && match(_slots[i].ref))
+                    return i;
+            }
+        }
+        const Ref& ref(size_type i) const {
+            return _slots[i].ref;
+        }
+        void set_ref(size_type i, const Ref& r) {
+            _slots[i].ref = r;
+        }
+        //Add an entry known to be absent.
+        void insert(size_t h, const Ref& r) {
+            if (2 * (_size + 1) > _slots.size())
+                rehash(_slots.empty() ? 8 : 2 * _slots.size());
+            place(tag(h), r);
+            ++_size;
+        }
+        void erase(size_type i) {
+            size_type j = i;
+            for ( ; ; ) {
+                j = (j + 1) & _mask;
+                if (_slots[j].hash == 0)
+                    break;
+                size_type home = _slots[j].hash & _mask;
+                //Shift j back to the hole unless its home lies in (i, j].
+                bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                if (!stays) {
+                    _slots[i] = _slots[j];
+                    i = j;
+                }
+            }
+            _slots[i].hash = 0;
+            --_size;
+        }
+        void clear() {
+            for (size_type i = 0; i < _slots.size(); ++i)
+                _slots[i].hash = 0;
+            _size = 0;
+        }
+    private:
+        //Hash 0 marks an empty slot.
+        class slot {
+        public:
+            size_t hash;
+            Ref ref;
+
+            slot(): hash(0), ref() {}
+        };
+
+        vector<slot> _slots;
+        size_type _mask;
+        size_type _size;
+
+        static size_t tag(size_t h) {
+            return h == 0 ? 1 : h;
+        }
+        void place(size_t h, const Ref& r) {
+            size_type i = h & _mask;
+            while (_slots[i].hash != 0)
+                i = (i + 1) & _mask;
+            _slots[i].hash = h;
+            _slots[i].ref = r;
+        }
+        void rehash(size_type cap) {
+            vector<slot> old(cap);
+            old.swap(_slots);
+            _mask = cap - 1;
+            for (size_type i = 0; i < old.size(); ++i) {
+                if (old[i].hash != 0)
+                    place(old[i].hash, old[i].ref);
+            }
+        }
+    };
+    template<class Ref>
+    const typename _cache_index<Ref>::size_type _cache_index<Ref>::npos;
+
+    //Every entry weighs 1, capacity counts entries.
+    template<class K, class V>
+    class entry_weigher {
+    public:
+        size_t operator()(const K&, const V&) const {
+            return 1;
+        }
+    };
+
+    //Least recently used cache holding up to capacity weight, by default
+    //capacity entries. A Weigher returning e.g. bytes makes it a byte budget.
+    //Entries sit in a list, most recent first, and a hit splices its node to
+    //the front in O(1). Evicted and erased nodes are kept on a spare list and
+    //reused, so once the cache has filled up it does not allocate again.
+    //Pointers returned by get stay valid until the entry is evicted or erased.
+    template<class K, class V, class Hash = hash<K>, class Weigher = entry_weigher<K, V> >
+    class lru_cache {
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef Hash hasher;
+        typedef size_t size_type;
+
+        explicit lru_cache(size_type capacity, const Weigher& weigher = Weigher(),
+                const Hash& hash = Hash()):
+            _capacity(capacity), _weight(0), _size(0), _hash(hash), _weigher(weigher) {}
+
+        size_type size() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        size_type capacity() const {
+            return _capacity;
+        }
+        //Total weight of the entries.
+        size_type weight() const {
+            return _weight;
+        }
+
+        //Value of key marked most recently used, 0 on a miss.
+        mapped_type* get(const key_type& key) {
+            return get(key, _hash(key));
+        }
+        //Value of key without touching the recency order.
+        const mapped_type* peek(const key_type& key) const {
+            size_type i = _index.find(_hash(key), key_match(&key));
+            return i == index_type::npos ? 0 : &_index.ref(i)->value;
+        }
+        bool contains(const key_type& key) const {
+            return peek(key) != 0;
+        }
+        //Insert or update key as the most recently used entry, evicting from
+        //the back until it fits. An entry heavier than the capacity is not kept.
+        void put(const key_type& key, const mapped_type& value) {
+            put(key, value, _hash(key));
+        }
+        bool erase(const key_type& key) {
+            return erase(key, _hash(key));
+        }
+        void clear() {
+            _spare.splice(_spare.end(), _entries);
+            _index.clear();
+            _weight = 0;
+            _size = 0;
+        }
+    private:
+        class entry {
+        public:
+            key_type key;
+            mapped_type value;
+            size_type weight;
+            size_t hash;
+
+            entry(const key_type& k, const mapped_type& v, size_type w, size_t h):
+                key(k), value(v), weight(w), hash(h) {}
+        };
+        typedef list<entry> list_type;
+        typedef typename list_type::iterator iterator;
+        typedef _cache_index<iterator> index_type;
+
+        class key_match {
+        public:
+            explicit key_match(const key_type* key): _key(key) {}
+            bool operator()(const iterator& it) const {
+                return it->key == *_key;
+            }
+        private:
+            const key_type* _key;
+        };
+        class node_match {
+        public:
+            explicit node_match(iterator it): _it(it) {}
+            bool operator()(const iterator& it) const {
+                return it == _it;
+            }
+        private:
+            iterator _it;
+        };
+
+        size_type _capacity;
+        size_type _weight;
+        size_type _size;
+        list_type _entries;
+        list_type _spare;
+        index_type _index;
+        Hash _hash;
+        Weigher _weigher;
+
+        template<class Cache>
+        friend class sharded_cache;
+
+        //Splicing after the sentinel puts a node at the front.
+        void to_front(iterator it) {
+            _entries.splice(_entries.end(), _entries, it);
+        }
+        mapped_type* get(const key_type& key, size_t h) {
+            size_type i = _index.find(h, key_match(&key));
+            if (i == index_type::npos)
+                return 0;
+            iterator it = _index.ref(i);
+            to_front(it);
+            return &it->value;
+        }
+        void put(const key_type& key, const mapped_type& value, size_t h) {
+            size_type w = _weigher(key, value);
+            size_type i = _index.find(h, key_match(&key));
+            if (i != index_type::npos) {
+                iterator it = _index.ref(i);
+                if (w > _capacity) {
+                    remove(i, it);
+                    return;
+                }
+                _weight = _weight - it->weight + w;
+                it->value = value;
+                it->weight = w;
+                to_front(it);
+                while (_weight > _capacity)
+                    evict();
+                return;
+            }
+            if (w > _capacity)
+                return;
+            while (_size > 0 && _weight + w > _capacity)
+                evict();
+            iterator it;
+            if (!_spare.empty()) {
+                it = _spare.begin();
+                _entries.splice(_entries.end(), _spare, it);
+                it->key = key;
+                it->value = value;
+                it->weight = w;
+                it->hash = h;
+            } else {
+                it = _entries.insert(_entries.end(), entry(key, value, w, h));
+            }
+            _index.insert(h, it);
+            _weight += w;
+            ++_size;
+        }
+        bool erase(const key_type& key, size_t h) {
+            size_type i = _index.find(h, key_match(&key));
+            if (i == index_type::npos)
+                return false;
+            remove(i, _index.ref(i));
+            return true;
+        }
+        //Drop the least recently used entry.
+        void evict() {
+            iterator it = --_entries.end();
+            remove(_index.find(it->hash, node_match(it)), it);
+        }
+        void remove(size_type i, iterator it) {
+            _index.erase(i);
+            _weight -= it->weight;
+            --_size;
+            _spare.splice(_spare.end(), _entries, it);
+        }
+    };
+
+    //CLOCK (second chance) cache of up to capacity entries.
+    //Entries live in one array with a referenced bit each. A hit only sets
+    //the bit, and only if it is clear, so hot entries cost no writes and
+    //no pointer updates. To evict, the hand sweeps the array, clearing set
+    //bits, and takes the first entry whose bit was already clear.
+    //The array is allocated once, erased slots are reused first.
+    template<class K, class V, class Hash = hash<K> >
+    class clock_cache {
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef Hash hasher;
+        typedef size_t size_type;
+
+        explicit clock_cache(size_type capacity, const Hash& hash = Hash()):
+            _capacity(capacity), _hand(0), _hash(hash) {
+            _entries.reserve(capacity);
+            _free.reserve(capacity);
+            _index.reserve(capacity);
+        }
+
+        size_type size() const {
+            return _index.size();
+        }
+        bool empty() const {
+            return _index.size() == 0;
+        }
+        size_type capacity() const {
+            return _capacity;
+        }
+
+        mapped_type* get(const key_type& key) {
+            return get(key, _hash(key));
+        }
+        //Value of key without setting its referenced bit.
+        const mapped_type* peek(const key_type& key) const {
+            size_type i = _index.find(_hash(key), key_match(&_entries, &key));
+            return i == index_type::npos ? 0 : &_entries[_index.ref(i)].value;
+        }
+        bool contains(const key_type& key) const {
+            return peek(key) != 0;
+        }
+        void put(const key_type& key, const mapped_type& value) {
+            put(key, value, _hash(key));
+        }
+        bool erase(const key_type& key) {
+            return erase(key, _hash(key));
+        }
+        void clear() {
+            _entries.clear();
+            _free.clear();
+            _index.clear();
+            _hand = 0;
+        }
+    private:
+        class entry {
+        public:
+            key_type key;
+            mapped_type value;
+            size_t hash;
+            bool referenced;
+
+            entry(const key_type& k, const mapped_type& v, size_t h):
+                key(k), value(v), hash(h), referenced(false) {}
+        };
+        typedef _cache_index<size_type> index_type;
+
+        class key_match {
+        public:
+            key_match(const vector<entry>* entries, const key_type* key): _entries(entries), _key(key) {}
+            bool operator()(size_type i) const {
+                return (*_entries)[i].key == *_key;
+            }
+        private:
+            const vector<entry>* _entries;
+            const key_type* _key;
+        };
+        class slot_match {
+        public:
+            explicit slot_match(size_type i): _i(i) {}
+            bool operator()(size_type i) const {
+                return i == _i;
+            }
+        private:
+            size_type _i;
+        };
+
+        size_type _capacity;
+        size_type _hand;
+        vector<entry> _entries;
+        //Erased slots of _entries.
+        vector<size_type> _free;
+        index_type _index;
+        Hash _hash;
+
+        template<class Cache>
+        friend class sharded_cache;
+
+        mapped_type* get(const key_type& key, size_t h) {
+            size_type i = _index.find(h, key_match(&_entries, &key));
+            if (i == index_type::npos)
+                return 0;
+            entry& e = _entries[_index.ref(i)];
+            if (!e.referenced)
+                e.referenced = true;
+            return &e.value;
+        }
+        void put(const key_type& key, const mapped_type& value, size_t h) {
+            if (_capacity == 0)
+                return;
+            size_type i = _index.find(h, key_match(&_entries, &key));
+            if (i != index_type::npos) {
+                entry& e = _entries[_index.ref(i)];
+                e.value = value;
+                e.referenced = true;
+                return;
+            }
+            size_type s;
+            if (!_free.empty()) {
+                s = _free.back();
+                _free.pop_back();
+            } else if (_entries.size() < _capacity) {
+                _entries.push_back(entry(key, value, h));
+                _index.insert(h, _entries.size() - 1);
+                return;
+            } else {
+                s = sweep();
+                _index.erase(_index.find(_entries[s].hash, slot_match(s)));
+            }
+            entry& e = _entries[s];
+            e.key = key;
+            e.value = value;
+            e.hash = h;
+            e.referenced = false;
+            _index.insert(h, s);
+        }
+        bool erase(const key_type& key, size_t h) {
+            size_type i = _index.find(h, key_match(&_entries, &key));
+            if (i == index_type::npos)
+                return false;
+            _free.push_back(_index.ref(i));
+            _index.erase(i);
+            return true;
+        }
+        //Advance the hand to the victim. Runs only with every slot in use.
+        size_type sweep() {
+            for ( ; ; ) {
+                size_type i = _hand;
+                _hand = _hand + 1 == _entries.size() ? 0 : _hand + 1;
+                if (!_entries[i].referenced)
+                    return i;
+                _entries[i].referenced = false;
+            }
+        }
+    };
+
+    //Thread safe cache made of independent shards, each a Cache behind its
+    //own mutex. The key hash picks the shard by its high bits, the shard
+    //index uses the low bits, and the hash is computed once per call.
+    //Values are copied out under the lock, since a pointer into a shard
+    //would not be safe once the lock is released.
+    template<class Cache>
+    class sharded_cache {
+    public:
+        typedef typename Cache::key_type key_type;
+        typedef typename Cache::mapped_type mapped_type;
+        typedef typename Cache::hasher hasher;
+        typedef size_t size_type;
+
+        //capacity is split evenly, shards is rounded up to a power of two.
+        explicit sharded_cache(size_type capacity, size_type shards = 16): _count(1) {
+            while (_count < shards)
+                _count *= 2;
+            _shift = 0;
+            while (((size_type)1 << _shift) < _count)
+                ++_shift;
+            size_type each = (capacity + _count - 1) / _count;
+            _shards = shard_allocator.allocate(_count);
+            for (size_type i = 0; i < _count; ++i)
+                new(_shards + i) shard(each);
+        }
+        ~sharded_cache() {
+            for (size_type i = 0; i < _count; ++i)
+                _shards[i].~shard();
+            shard_allocator.deallocate(_shards, _count);
+        }
+
+        //Copy the value of key to value, false on a miss.
+        bool get(const key_type& key, mapped_type& value) {
+            size_t h = _hash(key);
+            shard& s = pick(h);
+            std::lock_guard<std::mutex> guard(s.lock);
+            const mapped_type* p = s.cache.get(key, h);
+            if (0 == p)
+                return false;
+            value = *p;
+            return true;
+        }
+        void put(const key_type& key, const mapped_type& value) {
+            size_t h = _hash(key);
+            shard& s = pick(h);
+            std::lock_guard<std::mutex> guard(s.lock);
+            s.cache.put(key, value, h);
+        }
+        bool erase(const key_type& key) {
+            size_t h = _hash(key);
+            shard& s = pick(h);
+            std::lock_guard<std::mutex> guard(s.lock);
+            return s.cache.erase(key, h);
+        }
+        bool contains(const key_type& key) {
+            shard& s = pick(_hash(key));
+            std::lock_guard<std::mutex> guard(s.lock);
+            return s.cache.contains(key);
+        }
+        //Sum of the shard sizes, each read under its lock.
+        size_type size() {
+            size_type n = 0;
+            for (size_type i = 0; i < _count; ++i) {
+                std::lock_guard<std::mutex> guard(_shards[i].lock);
+                n += _shards[i].cache.size();
+            }
+            return n;
+        }
+        void clear() {
+            for (size_type i = 0; i < _count; ++i) {
+                std::lock_guard<std::mutex> guard(_shards[i].lock);
+                _shards[i].cache.clear();
+            }
+        }
+        size_type shard_count() const {
+            return _count;
+        }
+    private:
+        //One cache line per shard at least, so locks do not share lines.
+        class alignas(64) shard {
+        public:
+            std::mutex lock;
+            Cache cache;
+
+            explicit shard(size_type capacity): cache(capacity) {}
+        };
+
+        shard* _shards;
+        size_type _count;
+        size_type _shift;
+        hasher _hash;
+        allocator<shard> shard_allocator;
+
+        sharded_cache(const sharded_cache&);
+        sharded_cache& operator=(const sharded_cache&);
+
+        shard& pick(size_t h) {
+            return _shift == 0 ? _shards[0] : _shards[h >> (sizeof(size_t) * 8 - _shift)];
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef MY_PARALLEL_H
+#define MY_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <exception>
+#include <thread>
+#include "my_allocator.h"
+#include "my_uninitialized.h"
+#include "my_iterator.h"
+#include "my_type_traits.h"
+
+namespace mystl {
+
+    //Tag asking for construction split across threads.
+    //Linux places a page on the memory node of the thread that first writes
+    //it, so building a big buffer on one thread puts all of it on one node.
+    //With this policy every thread builds its own page aligned chunk.
+    //threads 0 means one per hardware thread. Ranges shorter than
+    //min_chunk_bytes per thread use fewer threads, down to the caller alone.
+    class parallel_policy {
+    public:
+        unsigned threads;
+        size_t min_chunk_bytes;
+
+        explicit parallel_policy(unsigned t = 0, size_t min_chunk = (size_t)1 << 20):
+            threads(t), min_chunk_bytes(min_chunk) {}
+    };
+    const parallel_policy parallel = parallel_policy();
+
+    const size_t _page_size = 4096;
+
+    //Run one chunk, keeping its exception for the caller.
+    template<class Body>
+    void _parallel_chunk(Body body, size_t b, size_t e, std::exception_ptr* error) {
+        try {
+            body(b, e);
+        } catch (...) {
+            *error = std::current_exception();
+        }
+    }
+    //Run body(b, e) over [0, n) in chunks on several threads, chunk 0 on the
+    //caller. The chunk edges fall on page edges of first, an array of T.
+    //body constructs [b, e) and destroys what it built before throwing.
+    //If a chunk throws, the chunks that finished are destroyed too and the
+    //first exception is rethrown, so nothing is left constructed.
+    template<class T, class Body>
+    void _parallel_construct(T* first, size_t n, const parallel_policy& policy, Body body) {
+        size_t bytes = n * sizeof(T);
+        size_t count = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+        if (count == 0)
+            count = 1;
+        size_t most = policy.min_chunk_bytes ? bytes / policy.min_chunk_bytes : count;
+        if (count > most)
+            count = most;
+        if (count <= 1) {
+            body((size_t)0, n);
+            return;
+        }
+        //Chunk k starts at the first element that begins on or after the
+        //page edge closest to byte k * bytes / count.
+        allocator<size_t> edge_allocator;
+        size_t* edges = edge_allocator.allocate(count + 1);
+        uintptr_t base = (uintptr_t)first;
+        edges[0] = 0;
+        for (size_t k = 1; k < count; ++k) {
+            uintptr_t target = base + bytes / count * k;
+            target = (target + _page_size - 1) & ~(uintptr_t)(_page_size - 1);
+            size_t e = (size_t)((target - base + sizeof(T) - 1) / sizeof(T));
+            edges[k] = e < edges[k - 1] ? edges[k - 1] : (e > n ? n : e);
+        }
+        edges[count] = n;
+
+        allocator<std::exception_ptr> error_allocator;
+        std::exception_ptr* errors = error_allocator.allocate(count);
+        for (size_t k = 0; k < count; ++k)
+            new(errors + k) std::exception_ptr();
+        allocator<std::thread> thread_allocator;
+        std::thread* threads = thread_allocator.allocate(count);
+        size_t started = 1;
+        for ( ; started < count; ++started) {
+            try {
+                new(threads + started) std::thread(_parallel_chunk<Body>, body,
+                        edges[started], edges[started + 1], errors + started);
+            } catch (...) {
+                break;
+            }
+        }
+        //Chunks that got no thread run here.
+        _parallel_chunk(body, edges[0], edges[1], errors);
+        for (size_t k = started; k < count; ++k)
+            _parallel_chunk(body, edges[k], edges[k + 1], errors + k);
+        for (size_t k = 1; k < started; ++k) {
+            threads[k].join();
+            threads[k].~thread();
+        }
+        thread_allocator.deallocate(threads, count);
+
+        std::exception_ptr error;
+        for (size_t k = 0; k < count && !error; ++k)
+            error = errors[k];
+        if (error) {
+            for (size_t k = 0; k < count; ++k) {
+                if (!errors[k]) {
+                    for (size_t i = edges[k]; i < edges[k + 1]; ++i)
+                        _destroy(first + i);
+                }
+            }
+        }
+        for (size_t k = 0; k < count; ++k)
+            errors[k].~exception_ptr();
+        error_allocator.deallocate(errors, count);
+        edge_allocator.deallocate(edges, count + 1);
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    //Chunk bodies. Trivially copyable types go through the serial kernels
+    //with their memset and memmove paths, which can not throw.
+    template<class T>
+    class _fill_chunk {
+    public:
+        _fill_chunk(T* first, const T& value): _first(first), _value(&value) {}
+        void operator()(size_t b, size_t e) const {
+            fill(b, e, typename is_trivially_copyable<T>::type());
+        }
+    private:
+        T* _first;
+        const T* _value;
+
+        void fill(size_t b, size_t e, true_type) const {
+            uninitialized_fill_n(_first + b, e - b, *_value);
+        }
+        void fill(size_t b, size_t e, false_type) const {
+            size_t i = b;
+            try {
+                for ( ; i < e; ++i)
+                    new(_first + i) T(*_value);
+            } catch (...) {
+                for (size_t j = b; j < i; ++j)
+                    _destroy(_first + j);
+                throw;
+            }
+        }
+    };
+    template<class RandomAccessIterator, class T>
+    class _copy_chunk {
+    public:
+        _copy_chunk(RandomAccessIterator src, T* first): _src(src), _first(first) {}
+        void operator()(size_t b, size_t e) const {
+            copy(b, e, typename is_trivially_copyable<T>::type());
+        }
+    private:
+        RandomAccessIterator _src;
+        T* _first;
+
+        void copy(size_t b, size_t e, true_type) const {
+            uninitialized_copy(_src + b, _src + e, _first + b);
+        }
+        void copy(size_t b, size_t e, false_type) const {
+            size_t i = b;
+            try {
+                for ( ; i < e; ++i)
+                    new(_first + i) T(_src[i]);
+            } catch (...) {
+                for (size_t j = b; j < i; ++j)
+                    _destroy(_first + j);
+                throw;
+            }
+        }
+    };
+
+    //Fill n raw elements at first with value, on several threads.
+    template<class T>
+    void parallel_uninitialized_fill_n(T* first, size_t n, const T& value,
+            const parallel_policy& policy = parallel) {
+        _parallel_construct(first, n, policy, _fill_chunk<T>(first, value));
+    }
+    //Copy construct [first, last) into raw elements at result, on several
+    //threads. Ranges without random access are copied by the caller alone.
+    template<class InputIterator, class T>
+    T* _parallel_uninitialized_copy(InputIterator first, InputIterator last, T* result,
+            const parallel_policy&, input_iterator_tag) {
+        T* cur = result;
+        try {
+            for ( ; first != last; ++first, ++cur)
+                new(cur) T(*first);
+        } catch (...) {
+            for ( ; result != cur; ++result)
+                _destroy(result);
+            throw;
+        }
+        return cur;
+    }
+    template<class RandomAccessIterator, class T>
+    T* _parallel_uninitialized_copy(RandomAccessIterator first, RandomAccessIterator last, T* result,
+            const parallel_policy& policy, random_access_iterator_tag) {
+        size_t n = last - first;
+        _parallel_construct(result, n, policy, _copy_chunk<RandomAccessIterator, T>(first, result));
+        return result + n;
+    }
+    template<class InputIterator, class T>
+    T* parallel_uninitialized_copy(InputIterator first, InputIterator last, T* result,
+            const parallel_policy& policy = parallel) {
+        return _parallel_uninitialized_copy(first, last, result, policy,
+                typename iterator_traits<InputIterator>::iterator_category());
+    }
+}
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef MY_QUEUE_H
+#define MY_QUEUE_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdexcept>
+#include "my_vector.h"
+#include "my_heap.h"
+#include "my_function.h"
+
+namespace mystl {
+
+    //Priority queue on a d-ary heap, largest element under Compare on top.
+    //D = 4 keeps the four children of a node next to each other, which halves
+    //the depth of the tree compared to the binary heap.
+    template<class T, size_t D = 4, class Container = vector<T>,
+            class Compare = less<typename Container::value_type> >
+    class dary_priority_queue {
+    public:
+        typedef Container container_type;
+        typedef typename Container::value_type value_type;
+        typedef typename Container::size_type size_type;
+        typedef typename Container::reference reference;
+        typedef typename Container::const_reference const_reference;
+
+        static const size_t arity = D;
+
+        //Constructors.
+        explicit dary_priority_queue(const Compare& comp = Compare()): _comp(comp) {}
+        template<class InputIterator>
+        dary_priority_queue(InputIterator first, InputIterator last, const Compare& comp = Compare()):
+            _comp(comp) {
+            for ( ; first != last; ++first)
+                _c.push_back(*first);
+            make_dary_heap<D>(_c.begin(), _c.end(), _comp);
+        }
+
+        bool empty() const {
+            return _c.empty();
+        }
+        size_type size() const {
+            return _c.size();
+        }
+        const_reference top() const {
+            return _c.front();
+        }
+        void push(const value_type& value) {
+            _c.push_back(value);
+            push_dary_heap<D>(_c.begin(), _c.end(), _comp);
+        }
+        void pop() {
+            pop_dary_heap<D>(_c.begin(), _c.end(), _comp);
+            _c.pop_back();
+        }
+        void reserve(size_type n) {
+            _c.reserve(n);
+        }
+        void clear() {
+            _c.clear();
+        }
+        void swap(dary_priority_queue& x) {
+            _c.swap(x._c);
+            mystl::swap(_comp, x._comp);
+        }
+    protected:
+        Container _c;
+        Compare _comp;
+    };
+
+    //Priority queue on a binary heap.
+    template<class T, class Container = vector<T>, class Compare = less<typename Container::value_type> >
+    class priority_queue: public dary_priority_queue<T, 2, Container, Compare> {
+    public:
+        explicit priority_queue(const Compare& comp = Compare()):
+            dary_priority_queue<T, 2, Container, Compare>(comp) {}
+        template<class InputIterator>
+        priority_queue(InputIterator first, InputIterator last, const Compare& comp = Compare()):
+            dary_priority_queue<T, 2, Container, Compare>(first, last, comp) {}
+    };
+
+    //Addressable d-ary heap. push returns a handle that stays valid until the
+    //element is popped or erased, and the value behind a handle can be changed
+    //in O(log n), e.g. to reschedule a timer.
+    template<class T, class Compare = less<T>, size_t D = 4>
+    class indexed_heap {
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef size_t handle_type;
+
+        static const handle_type npos = (handle_type)-1;
+
+        explicit indexed_heap(const Compare& comp = Compare()): _comp(comp), _free(npos) {}
+
+        bool empty() const {
+            return _heap.empty();
+        }
+        size_type size() const {
+            return _heap.size();
+        }
+        const value_type& top() const {
+            return _values[_heap.front()];
+        }
+        handle_type top_handle() const {
+            return _heap.front();
+        }
+        //Value behind a live handle.
+        const value_type& get(handle_type h) const {
+            return _values[h];
+        }
+        bool contains(handle_type h) const {
+            return h < _pos.size() && _pos[h] != npos;
+        }
+
+        handle_type push(const value_type& value) {
+            handle_type h;
+            if (_free != npos) {
+                //Reuse a released handle.
+                h = _free;
+                _free = _next_free[h];
+                _values[h] = value;
+            } else {
+                h = _values.size();
+                _values.push_back(value);
+                _pos.push_back(npos);
+                _next_free.push_back(npos);
+            }
+            _heap.push_back(h);
+            _pos[h] = _heap.size() - 1;
+            sift_up(_heap.size() - 1);
+            return h;
+        }
+        void pop() {
+            assert(!_heap.empty());
+            erase(_heap.front());
+        }
+        //Remove the element behind h, which must be live.
+        void erase(handle_type h) {
+            assert(contains(h));
+            size_type i = _pos[h];
+            size_type last = _heap.size() - 1;
+            _pos[h] = npos;
+            _next_free[h] = _free;
+            _free = h;
+            if (i != last) {
+                _heap[i] = _heap[last];
+                _pos[_heap[i]] = i;
+                _heap.pop_back();
+                sift_down(sift_up(i));
+            } else {
+                _heap.pop_back();
+            }
+        }
+        //Replace the value behind h and restore the heap in either direction.
+        void update(handle_type h, const value_type& value) {
+            assert(contains(h));
+            _values[h] = value;
+            sift_down(sift_up(_pos[h]));
+        }
+        //Replace the value behind h with one that does not come after it
+        //under Compare, so it only moves toward the top. The name is for the
+        //usual min-heap, greater<T>, where this lowers the key; with the
+        //default less<T> the key must grow instead. Use update otherwise.
+        void decrease_key(handle_type h, const value_type& value) {
+            assert(contains(h) && !_comp(value, _values[h]));
+            _values[h] = value;
+            sift_up(_pos[h]);
+        }
+        //Same as decrease_key, named for what it does under any Compare.
+        void promote(handle_type h, const value_type& value) {
+            decrease_key(h, value);
+        }
+        void clear() {
+            _heap.clear();
+            _values.clear();
+            _pos.clear();
+            _next_free.clear();
+            _free = npos;
+        }
+    private:
+        Compare _comp;
+        //Heap of handles.
+        vector<handle_type> _heap;
+        //Values and heap positions indexed by handle.
+        vector<value_type> _values;
+        vector<size_type> _pos;
+        //Chain of released handles.
+        vector<handle_type> _next_free;
+        handle_type _free;
+
+        bool before(size_type l, size_type r) const {
+            return _comp(_values[_heap[l]], _values[_heap[r]]);
+        }
+        void place(size_type i, handle_type h) {
+            _heap[i] = h;
+            _pos[h] = i;
+        }
+        size_type sift_up(size_type i) {
+            handle_type h = _heap[i];
+            while (i > 0) {
+                size_type parent = (i - 1) / D;
+                if (!_comp(_values[_heap[parent]], _values[h]))
+                    break;
+                place(i, _heap[parent]);
+                i = parent;
+            }
+            place(i, h);
+            return i;
+        }
+        size_type sift_down(size_type i) {
+            handle_type h = _heap[i];
+            size_type len = _heap.size();
+            for ( ; ; ) {
+                size_type child = D * i + 1;
+                if (child >= len)
+                    break;
+                size_type best = child;
+                size_type end = child + D < len ? child + D : len;
+                for (size_type c = child + 1; c < end; ++c) {
+                    if (before(best, c))
+                        best = c;
+                }
+                if (!_comp(_values[h], _values[_heap[best]]))
+                    break;
+                place(i, _heap[best]);
+                i = best;
+            }
+            place(i, h);
+            return i;
+        }
+    };
+    template<class T, class Compare, size_t D>
+    const typename indexed_heap<T, Compare, D>::handle_type indexed_heap<T, Compare, D>::npos;
+}
+
+#endif
@@ -0,0 +1,815 @@
+#ifndef MY_RANGES_H
+#define MY_RANGES_H
+
+#include <stddef.h>
+#include <utility>
+#include "my_iterator.h"
+#include "my_type_traits.h"
+#include "my_vector.h"
+
+namespace mystl {
+
+    //Lazy range views.
+    //A view holds its base view and computes elements while it is walked,
+    //so v | filter(p) | transform(f) | take(n) is one loop over v with no
+    //buffer in between, and to_vector at the end allocates once.
+    //Views keep containers by reference and other views by value. An
+    //iterator points back to its view for the predicate or function, so a
+    //view must outlive its iterators.
+    //Element-wise views keep the category of their base up to random access;
+    //views that cannot step back from end() in O(1) stop at forward.
+    class view_base {};
+
+    template<class T>
+    class _remove_cvref {
+    public:
+        typedef typename remove_const<typename remove_reference<T>::type>::type type;
+    };
+
+    //The weaker of two iterator categories.
+    template<class C1, class C2>
+    class _min_category {
+    public:
+        typedef typename conditional<is_base_of<C1, C2>::value, C1, C2>::type type;
+    };
+    //Iterators computed on the fly are never contiguous in memory.
+    template<class Category>
+    class _view_category {
+    public:
+        typedef typename _min_category<Category, random_access_iterator_tag>::type type;
+    };
+    //Category of views that only know their end by walking the base.
+    template<class Category>
+    class _sized_category {
+    public:
+        typedef typename conditional<is_base_of<random_access_iterator_tag, Category>::value,
+                random_access_iterator_tag,
+                typename _min_category<Category, forward_iterator_tag>::type>::type type;
+    };
+    template<class Iterator>
+    class _is_random_access: public integral_constant<bool, is_base_of<random_access_iterator_tag,
+            typename iterator_traits<Iterator>::iterator_category>::value> {};
+
+    //Step it forward n times, stopping at last.
+    template<class Iterator, class Distance>
+    Iterator _advance_bounded(Iterator it, Distance n, Iterator last, false_type) {
+        for ( ; n > 0 && it != last; --n)
+            ++it;
+        return it;
+    }
+    template<class Iterator, class Distance>
+    Iterator _advance_bounded(Iterator it, Distance n, Iterator last, true_type) {
+        return last - it < n ? last : it + n;
+    }
+    template<class Iterator, class Distance>
+    Iterator _advance_bounded(Iterator it, Distance n, Iterator last) {
+        return _advance_bounded(it, n, last, typename _is_random_access<Iterator>::type());
+    }
+
+    //Pair of iterators seen as a view.
+    template<class Iterator>
+    class iterator_range: public view_base {
+    public:
+        typedef Iterator iterator;
+        typedef typename iterator_traits<Iterator>::difference_type difference_type;
+
+        iterator_range() {}
+        iterator_range(Iterator first, Iterator last): _first(first), _last(last) {}
+
+        iterator begin() const {
+            return _first;
+        }
+        iterator end() const {
+            return _last;
+        }
+        bool empty() const {
+            return _first == _last;
+        }
+        difference_type size() const {
+            return distance(_first, _last);
+        }
+    private:
+        Iterator _first;
+        Iterator _last;
+    };
+
+    //View of a range: views are copied, containers are referred to.
+    template<class Range, bool IsView = is_base_of<view_base, typename remove_const<Range>::type>::value>
+    class _view_of {
+    public:
+        typedef typename remove_const<Range>::type type;
+
+        static type make(Range& r) {
+            return r;
+        }
+    };
+    template<class Range>
+    class _view_of<Range, false> {
+    public:
+        typedef iterator_range<decltype(declval<Range&>().begin())> type;
+
+        static type make(Range& r) {
+            return type(r.begin(), r.end());
+        }
+    };
+    //Views can be taken of lvalue containers and of any view.
+    template<class Range>
+    class _check_viewable {
+    public:
+        static_assert(is_base_of<view_base, typename _remove_cvref<Range>::type>::value
+                || !is_same<Range, typename remove_reference<Range>::type>::value,
+                "a view of a temporary container would dangle");
+    };
+
+    //Elements of the base for which pred holds.
+    template<class View, class Pred>
+    class filter_view: public view_base {
+    public:
+        typedef typename View::iterator base_iterator;
+
+        class iterator: public mystl::iterator<
+                typename _min_category<typename iterator_traits<base_iterator>::iterator_category,
+                        bidirectional_iterator_tag>::type,
+                typename iterator_traits<base_iterator>::value_type,
+                typename iterator_traits<base_iterator>::difference_type,
+                typename iterator_traits<base_iterator>::pointer,
+                typename iterator_traits<base_iterator>::reference> {
+        public:
+            typedef typename iterator_traits<base_iterator>::reference reference;
+
+            iterator(): _parent(0) {}
+            iterator(const filter_view* parent, base_iterator it): _parent(parent), _it(it) {}
+
+            reference operator*() const {
+                return *_it;
+            }
+            iterator& operator++() {
+                ++_it;
+                satisfy();
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            iterator& operator--() {
+                do {
+                    --_it;
+                } while (!_parent->_pred(*_it));
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp(*this);
+                --*this;
+                return temp;
+            }
+            bool operator==(const iterator& x) const {
+                return _it == x._it;
+            }
+            bool operator!=(const iterator& x) const {
+                return _it != x._it;
+            }
+            base_iterator base() const {
+                return _it;
+            }
+            friend class filter_view;
+        private:
+            const filter_view* _parent;
+            base_iterator _it;
+
+            void satisfy() {
+                base_iterator last = _parent->_base.end();
+                while (_it != last && !_parent->_pred(*_it))
+                    ++_it;
+            }
+        };
+
+        filter_view(const View& base, const Pred& pred): _base(base), _pred(pred) {}
+
+        iterator begin() const {
+            iterator it(this, _base.begin());
+            it.satisfy();
+            return it;
+        }
+        iterator end() const {
+            return iterator(this, _base.end());
+        }
+    private:
+        View _base;
+        Pred _pred;
+    };
+
+    //f applied to each element of the base.
+    template<class View, class F>
+    class transform_view: public view_base {
+    public:
+        typedef typename View::iterator base_iterator;
+        typedef decltype(declval<const F&>()(*declval<base_iterator>())) reference;
+        typedef typename _remove_cvref<reference>::type value_type;
+        typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+        class iterator: public mystl::iterator<
+                typename _view_category<typename iterator_traits<base_iterator>::iterator_category>::type,
+                value_type, difference_type, void, reference> {
+        public:
+            iterator(): _parent(0) {}
+            iterator(const transform_view* parent, base_iterator it): _parent(parent), _it(it) {}
+
+            reference operator*() const {
+                return _parent->_f(*_it);
+            }
+            reference operator[](difference_type n) const {
+                return _parent->_f(_it[n]);
+            }
+            iterator& operator++() {
+                ++_it;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++_it;
+                return temp;
+            }
+            iterator& operator--() {
+                --_it;
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp(*this);
+                --_it;
+                return temp;
+            }
+            iterator& operator+=(difference_type n) {
+                _it += n;
+                return *this;
+            }
+            iterator& operator-=(difference_type n) {
+                _it -= n;
+                return *this;
+            }
+            iterator operator+(difference_type n) const {
+                return iterator(_parent, _it + n);
+            }
+            iterator operator-(difference_type n) const {
+                return iterator(_parent, _it - n);
+            }
+            difference_type operator-(const iterator& x) const {
+                return _it - x._it;
+            }
+            bool operator==(const iterator& x) const {
+                return _it == x._it;
+            }
+            bool operator!=(const iterator& x) const {
+                return _it != x._it;
+            }
+            bool operator<(const iterator& x) const {
+                return _it < x._it;
+            }
+            base_iterator base() const {
+                return _it;
+            }
+        private:
+            const transform_view* _parent;
+            base_iterator _it;
+        };
+
+        transform_view(const View& base, const F& f): _base(base), _f(f) {}
+
+        iterator begin() const {
+            return iterator(this, _base.begin());
+        }
+        iterator end() const {
+            return iterator(this, _base.end());
+        }
+    private:
+        View _base;
+        F _f;
+    };
+
+    //The first n elements of the base, or all of it if shorter.
+    template<class View>
+    class take_view: public view_base {
+    public:
+        typedef typename View::iterator base_iterator;
+        typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+        //Counts its position, so the end is found without walking the base.
+        class iterator: public mystl::iterator<
+                typename _sized_category<typename iterator_traits<base_iterator>::iterator_category>::type,
+                typename iterator_traits<base_iterator>::value_type, difference_type,
+                typename iterator_traits<base_iterator>::pointer,
+                typename iterator_traits<base_iterator>::reference> {
+        public:
+            typedef typename iterator_traits<base_iterator>::reference reference;
+
+            iterator(): _n(0) {}
+            iterator(base_iterator it, difference_type n): _it(it), _n(n) {}
+
+            reference operator*() const {
+                return *_it;
+            }
+            reference operator[](difference_type n) const {
+                return _it[n];
+            }
+            iterator& operator++() {
+                ++_it;
+                ++_n;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            iterator& operator--() {
+                --_it;
+                --_n;
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp(*this);
+                --*this;
+                return temp;
+            }
+            iterator& operator+=(difference_type n) {
+                _it += n;
+                _n += n;
+                return *this;
+            }
+            iterator& operator-=(difference_type n) {
+                _it -= n;
+                _n -= n;
+                return *this;
+            }
+            iterator operator+(difference_type n) const {
+                return iterator(_it + n, _n + n);
+            }
+            iterator operator-(difference_type n) const {
+                return iterator(_it - n, _n - n);
+            }
+            difference_type operator-(const iterator& x) const {
+                return _n - x._n;
+            }
+            //Either the count ran out or the base did.
+            bool operator==(const iterator& x) const {
+                return _n == x._n || _it == x._it;
+            }
+            bool operator!=(const iterator& x) const {
+                return !(*this == x);
+            }
+            bool operator<(const iterator& x) const {
+                return _n < x._n;
+            }
+            base_iterator base() const {
+                return _it;
+            }
+        private:
+            base_iterator _it;
+            difference_type _n;
+        };
+
+        take_view(const View& base, difference_type n): _base(base), _count(n < 0 ? 0 : n) {}
+
+        iterator begin() const {
+            return iterator(_base.begin(), 0);
+        }
+        iterator end() const {
+            return end(typename _is_random_access<base_iterator>::type());
+        }
+    private:
+        View _base;
+        difference_type _count;
+
+        iterator end(true_type) const {
+            base_iterator first = _base.begin();
+            base_iterator last = _advance_bounded(first, _count, _base.end());
+            return iterator(last, last - first);
+        }
+        iterator end(false_type) const {
+            return iterator(_base.end(), _count);
+        }
+    };
+
+    //The base without its first n elements.
+    template<class View>
+    class drop_view: public view_base {
+    public:
+        typedef typename View::iterator iterator;
+        typedef typename iterator_traits<iterator>::difference_type difference_type;
+
+        drop_view(const View& base, difference_type n): _base(base), _count(n < 0 ? 0 : n) {}
+
+        iterator begin() const {
+            return _advance_bounded(_base.begin(), _count, _base.end());
+        }
+        iterator end() const {
+            return _base.end();
+        }
+    private:
+        View _base;
+        difference_type _count;
+    };
+
+    //Pairs of elements of two views at the same position, as long as the shorter.
+    template<class View1, class View2>
+    class zip_view: public view_base {
+    public:
+        typedef typename View1::iterator base_iterator1;
+        typedef typename View2::iterator base_iterator2;
+        typedef std::pair<typename iterator_traits<base_iterator1>::reference,
+                typename iterator_traits<base_iterator2>::reference> reference;
+        typedef std::pair<typename _remove_cvref<typename iterator_traits<base_iterator1>::value_type>::type,
+                typename _remove_cvref<typename iterator_traits<base_iterator2>::value_type>::type> value_type;
+        typedef ptrdiff_t difference_type;
+
+        class iterator: public mystl::iterator<
+                typename _sized_category<typename _min_category<
+                        typename iterator_traits<base_iterator1>::iterator_category,
+                        typename iterator_traits<base_iterator2>::iterator_category>::type>::type,
+                value_type, difference_type, void, reference> {
+        public:
+            iterator() {}
+            iterator(base_iterator1 a, base_iterator2 b): _a(a), _b(b) {}
+
+            reference operator*() const {
+                return reference(*_a, *_b);
+            }
+            reference operator[](difference_type n) const {
+                return reference(_a[n], _b[n]);
+            }
+            iterator& operator++() {
+                ++_a;
+                ++_b;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            iterator& operator--() {
+                --_a;
+                --_b;
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp(*this);
+                --*this;
+                return temp;
+            }
+            iterator& operator+=(difference_type n) {
+                _a += n;
+                _b += n;
+                return *this;
+            }
+            iterator& operator-=(difference_type n) {
+                _a -= n;
+                _b -= n;
+                return *this;
+            }
+            iterator operator+(difference_type n) const {
+                return iterator(_a + n, _b + n);
+            }
+            iterator operator-(difference_type n) const {
+                return iterator(_a - n, _b - n);
+            }
+            difference_type operator-(const iterator& x) const {
+                return _a - x._a;
+            }
+            //Either side reaching its end ends the zip.
+            bool operator==(const iterator& x) const {
+                return _a == x._a || _b == x._b;
+            }
+            bool operator!=(const iterator& x) const {
+                return !(*this == x);
+            }
+            bool operator<(const iterator& x) const {
+                return _a < x._a;
+            }
+        private:
+            base_iterator1 _a;
+            base_iterator2 _b;
+        };
+
+        zip_view(const View1& a, const View2& b): _a(a), _b(b) {}
+
+        iterator begin() const {
+            return iterator(_a.begin(), _b.begin());
+        }
+        iterator end() const {
+            return end(integral_constant<bool, _is_random_access<base_iterator1>::value
+                    && _is_random_access<base_iterator2>::value>());
+        }
+    private:
+        View1 _a;
+        View2 _b;
+
+        iterator end(true_type) const {
+            difference_type n = _a.end() - _a.begin();
+            difference_type m = _b.end() - _b.begin();
+            if (m < n)
+                n = m;
+            return iterator(_a.begin() + n, _b.begin() + n);
+        }
+        iterator end(false_type) const {
+            return iterator(_a.end(), _b.end());
+        }
+    };
+
+    //Pairs of position and element.
+    template<class View>
+    class enumerate_view: public view_base {
+    public:
+        typedef typename View::iterator base_iterator;
+        typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+        typedef std::pair<size_t, typename iterator_traits<base_iterator>::reference> reference;
+        typedef std::pair<size_t, typename _remove_cvref<
+                typename iterator_traits<base_iterator>::value_type>::type> value_type;
+
+        class iterator: public mystl::iterator<
+                typename _sized_category<typename iterator_traits<base_iterator>::iterator_category>::type,
+                value_type, difference_type, void, reference> {
+        public:
+            iterator(): _i(0) {}
+            iterator(base_iterator it, size_t i): _it(it), _i(i) {}
+
+            reference operator*() const {
+                return reference(_i, *_it);
+            }
+            reference operator[](difference_type n) const {
+                return reference(_i + n, _it[n]);
+            }
+            iterator& operator++() {
+                ++_it;
+                ++_i;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            iterator& operator--() {
+                --_it;
+                --_i;
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp(*this);
+                --*this;
+                return temp;
+            }
+            iterator& operator+=(difference_type n) {
+                _it += n;
+                _i += n;
+                return *this;
+            }
+            iterator& operator-=(difference_type n) {
+                _it -= n;
+                _i -= n;
+                return *this;
+            }
+            iterator operator+(difference_type n) const {
+                return iterator(_it + n, _i + n);
+            }
+            iterator operator-(difference_type n) const {
+                return iterator(_it - n, _i - n);
+            }
+            difference_type operator-(const iterator& x) const {
+                return _it - x._it;
+            }
+            bool operator==(const iterator& x) const {
+                return _it == x._it;
+            }
+            bool operator!=(const iterator& x) const {
+                return _it != x._it;
+            }
+            bool operator<(const iterator& x) const {
+                return _it < x._it;
+            }
+        private:
+            base_iterator _it;
+            size_t _i;
+        };
+
+        explicit enumerate_view(const View& base): _base(base) {}
+
+        iterator begin() const {
+            return iterator(_base.begin(), 0);
+        }
+        iterator end() const {
+            return end(typename _is_random_access<base_iterator>::type());
+        }
+    private:
+        View _base;
+
+        iterator end(true_type) const {
+            return iterator(_base.end(), _base.end() - _base.begin());
+        }
+        //Only compared against, the index does not matter.
+        iterator end(false_type) const {
+            return iterator(_base.end(), 0);
+        }
+    };
+
+    //Consecutive runs of n elements of the base, the last one may be shorter.
+    template<class View>
+    class chunk_view: public view_base {
+    public:
+        typedef typename View::iterator base_iterator;
+        typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+        typedef iterator_range<base_iterator> value_type;
+
+        class iterator: public mystl::iterator<forward_iterator_tag, value_type, difference_type,
+                void, value_type> {
+        public:
+            iterator(): _parent(0) {}
+            iterator(const chunk_view* parent, base_iterator it): _parent(parent), _it(it),
+                _next(_advance_bounded(it, parent->_count, parent->_base.end())) {}
+
+            value_type operator*() const {
+                return value_type(_it, _next);
+            }
+            iterator& operator++() {
+                _it = _next;
+                _next = _advance_bounded(_it, _parent->_count, _parent->_base.end());
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            bool operator==(const iterator& x) const {
+                return _it == x._it;
+            }
+            bool operator!=(const iterator& x) const {
+                return _it != x._it;
+            }
+        private:
+            const chunk_view* _parent;
+            base_iterator _it;
+            base_iterator _next;
+        };
+
+        chunk_view(const View& base, difference_type n): _base(base), _count(n < 1 ? 1 : n) {}
+
+        iterator begin() const {
+            return iterator(this, _base.begin());
+        }
+        iterator end() const {
+            return iterator(this, _base.end());
+        }
+    private:
+        View _base;
+        difference_type _count;
+    };
+
+    //Adaptors, applied to a range with |.
+    template<class Pred>
+    class _filter_adaptor {
+    public:
+        Pred pred;
+    };
+    template<class F>
+    class _transform_adaptor {
+    public:
+        F f;
+    };
+    class _take_adaptor {
+    public:
+        ptrdiff_t n;
+    };
+    class _drop_adaptor {
+    public:
+        ptrdiff_t n;
+    };
+    class _chunk_adaptor {
+    public:
+        ptrdiff_t n;
+    };
+    class _enumerate_adaptor {};
+    class _to_vector_adaptor {};
+
+    template<class Pred>
+    _filter_adaptor<Pred> filter(Pred pred) {
+        _filter_adaptor<Pred> a = { pred };
+        return a;
+    }
+    template<class F>
+    _transform_adaptor<F> transform(F f) {
+        _transform_adaptor<F> a = { f };
+        return a;
+    }
+    inline _take_adaptor take(ptrdiff_t n) {
+        _take_adaptor a = { n };
+        return a;
+    }
+    inline _drop_adaptor drop(ptrdiff_t n) {
+        _drop_adaptor a = { n };
+        return a;
+    }
+    inline _chunk_adaptor chunk(ptrdiff_t n) {
+        _chunk_adaptor a = { n };
+        return a;
+    }
+    inline _enumerate_adaptor enumerate() {
+        return _enumerate_adaptor();
+    }
+    inline _to_vector_adaptor to_vector() {
+        return _to_vector_adaptor();
+    }
+
+    template<class Range, class Pred>
+    filter_view<typename _view_of<typename remove_reference<Range>::type>::type, Pred>
+    operator|(Range&& r, const _filter_adaptor<Pred>& a) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return filter_view<typename base::type, Pred>(base::make(r), a.pred);
+    }
+    template<class Range, class F>
+    transform_view<typename _view_of<typename remove_reference<Range>::type>::type, F>
+    operator|(Range&& r, const _transform_adaptor<F>& a) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return transform_view<typename base::type, F>(base::make(r), a.f);
+    }
+    template<class Range>
+    take_view<typename _view_of<typename remove_reference<Range>::type>::type>
+    operator|(Range&& r, const _take_adaptor& a) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return take_view<typename base::type>(base::make(r), a.n);
+    }
+    template<class Range>
+    drop_view<typename _view_of<typename remove_reference<Range>::type>::type>
+    operator|(Range&& r, const _drop_adaptor& a) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return drop_view<typename base::type>(base::make(r), a.n);
+    }
+    template<class Range>
+    chunk_view<typename _view_of<typename remove_reference<Range>::type>::type>
+    operator|(Range&& r, const _chunk_adaptor& a) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return chunk_view<typename base::type>(base::make(r), a.n);
+    }
+    template<class Range>
+    enumerate_view<typename _view_of<typename remove_reference<Range>::type>::type>
+    operator|(Range&& r, const _enumerate_adaptor&) {
+        _check_viewable<Range> check;
+        (void)check;
+        typedef _view_of<typename remove_reference<Range>::type> base;
+        return enumerate_view<typename base::type>(base::make(r));
+    }
+    //Zip two ranges, e.g. zip(keys, values | transform(f)).
+    template<class Range1, class Range2>
+    zip_view<typename _view_of<typename remove_reference<Range1>::type>::type,
+            typename _view_of<typename remove_reference<Range2>::type>::type>
+    zip(Range1&& a, Range2&& b) {
+        _check_viewable<Range1> check1;
+        _check_viewable<Range2> check2;
+        (void)check1;
+        (void)check2;
+        typedef _view_of<typename remove_reference<Range1>::type> base1;
+        typedef _view_of<typename remove_reference<Range2>::type> base2;
+        return zip_view<typename base1::type, typename base2::type>(base1::make(a), base2::make(b));
+    }
+
+    template<class Vector, class Iterator>
+    void _reserve_for(Vector& v, Iterator first, Iterator last, true_type) {
+        v.reserve(last - first);
+    }
+    template<class Vector, class Iterator>
+    void _reserve_for(Vector&, Iterator, Iterator, false_type) {}
+    //Walk a range once and store its elements in a vector. The vector
+    //is sized up front when the range length is known without walking it.
+    template<class Range>
+    vector<typename _remove_cvref<typename iterator_traits<
+            decltype(declval<const Range&>().begin())>::value_type>::type>
+    to_vector(const Range& r) {
+        typedef decltype(r.begin()) iterator;
+        vector<typename _remove_cvref<typename iterator_traits<iterator>::value_type>::type> v;
+        iterator first = r.begin();
+        iterator last = r.end();
+        _reserve_for(v, first, last, typename _is_random_access<iterator>::type());
+        for ( ; first != last; ++first)
+            v.push_back(*first);
+        return v;
+    }
+    template<class Range>
+    vector<typename _remove_cvref<typename iterator_traits<
+            decltype(declval<const Range&>().begin())>::value_type>::type>
+    operator|(const Range& r, const _to_vector_adaptor&) {
+        return to_vector(r);
+    }
+}
+
+#endif
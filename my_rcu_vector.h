@@ -0,0 +1,123 @@
+#ifndef MY_RCU_VECTOR_H
+#define MY_RCU_VECTOR_H
+
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+#include "my_vector.h"
+#include "my_epoch.h"
+
+namespace mystl {
+
+    //Read-copy-update vector for tables read by every thread and rewritten
+    //rarely. Readers take a snapshot: one load of the current version inside
+    //an epoch read section, no lock and no write to a shared cache line.
+    //Writers are serialized, build a new version with vector's copy
+    //and then publish it. The old version is freed through the global epoch
+    //domain once no snapshot can still reach it.
+    template<class T, class Alloc = allocator<T> >
+    class rcu_vector {
+    public:
+        typedef vector<T, Alloc> vector_type;
+        typedef T value_type;
+        typedef const T& const_reference;
+        typedef typename vector_type::const_iterator const_iterator;
+        typedef size_t size_type;
+
+        //Consistent read only view of one version, valid while it lives.
+        //Snapshots nest and are cheap, but hold one for a short time only:
+        //versions retired meanwhile are not freed before it ends.
+        class snapshot {
+        public:
+            explicit snapshot(const rcu_vector& v): _version(v._current.load(std::memory_order_acquire)) {}
+
+            const vector_type& operator*() const {
+                return *_version;
+            }
+            const vector_type* operator->() const {
+                return _version;
+            }
+            const_iterator begin() const {
+                return _version->begin();
+            }
+            const_iterator end() const {
+                return _version->end();
+            }
+            size_type size() const {
+                return _version->size();
+            }
+            bool empty() const {
+                return _version->empty();
+            }
+            const_reference operator[](size_type n) const {
+                return (*_version)[n];
+            }
+        private:
+            //Constructed first, so the version is loaded inside the section.
+            epoch_guard _guard;
+            const vector_type* _version;
+
+            snapshot(const snapshot&);
+            snapshot& operator=(const snapshot&);
+        };
+
+        //Constructors.
+        rcu_vector(): _current(new vector_type()) {}
+        explicit rcu_vector(const vector_type& v): _current(new vector_type(v)) {}
+        explicit rcu_vector(vector_type&& v): _current(new vector_type(mystl::move(v))) {}
+        //Destructor. No snapshot of this vector may still be alive.
+        ~rcu_vector() {
+            delete _current.load(std::memory_order_relaxed);
+        }
+
+        //Copy the current version, let f change the copy, then publish it.
+        template<class Function>
+        void update(Function f) {
+            std::lock_guard<std::mutex> guard(_write_lock);
+            vector_type* next = new vector_type(*_current.load(std::memory_order_relaxed));
+            try {
+                f(*next);
+            } catch (...) {
+                delete next;
+                throw;
+            }
+            publish(next);
+        }
+        //Publish v as the next version.
+        void store(const vector_type& v) {
+            vector_type* next = new vector_type(v);
+            std::lock_guard<std::mutex> guard(_write_lock);
+            publish(next);
+        }
+        void store(vector_type&& v) {
+            vector_type* next = new vector_type(mystl::move(v));
+            std::lock_guard<std::mutex> guard(_write_lock);
+            publish(next);
+        }
+        //Copy of the current version.
+        vector_type load() const {
+            snapshot s(*this);
+            return *s;
+        }
+        //Wait until every version replaced so far is freed.
+        static void synchronize() {
+            epoch_domain::global().synchronize();
+        }
+    private:
+        std::atomic<vector_type*> _current;
+        std::mutex _write_lock;
+
+        rcu_vector(const rcu_vector&);
+        rcu_vector& operator=(const rcu_vector&);
+
+        static void destroy(void* p) {
+            delete static_cast<vector_type*>(p);
+        }
+        void publish(vector_type* next) {
+            vector_type* old = _current.exchange(next, std::memory_order_seq_cst);
+            epoch_domain::global().retire(old, &destroy);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef MY_SLOT_MAP_H
+#define MY_SLOT_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdexcept>
+#include "my_vector.h"
+#include "my_type_traits.h"
+
+namespace mystl {
+
+    //Key of a slot_map element: the slot it was given and the generation of
+    //that slot at the time. Once the element is erased the slot generation
+    //moves on, so old handles no longer resolve.
+    class slot_handle {
+    public:
+        uint32_t index;
+        uint32_t generation;
+
+        slot_handle(): index((uint32_t)-1), generation(0) {}
+        slot_handle(uint32_t i, uint32_t g): index(i), generation(g) {}
+    };
+    inline bool operator==(const slot_handle& l, const slot_handle& r) {
+        return l.index == r.index && l.generation == r.generation;
+    }
+    inline bool operator!=(const slot_handle& l, const slot_handle& r) {
+        return !(l == r);
+    }
+
+    //Container giving stable handles to elements kept densely in one array.
+    //Values sit contiguously in insertion order, except that erase moves the
+    //last value into the hole, so iterating is a plain T* walk and the bulk
+    //algorithms of my_algobase apply. A handle goes through a slot array to
+    //the current position of its value.
+    //Insert, erase and lookup are O(1). Pointers into the dense array are
+    //invalidated by insert and erase, handles only by erasing their element.
+    template<class T>
+    class slot_map {
+    public:
+        typedef T value_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef size_t size_type;
+        typedef slot_handle handle;
+
+        slot_map(): _free(end_of_free) {}
+
+        //Data access.
+        iterator begin() {
+            return data();
+        }
+        const_iterator begin() const {
+            return data();
+        }
+        iterator end() {
+            return data() + _values.size();
+        }
+        const_iterator end() const {
+            return data() + _values.size();
+        }
+        pointer data() {
+            return _values.empty() ? 0 : &_values[0];
+        }
+        const_pointer data() const {
+            return _values.empty() ? 0 : &_values[0];
+        }
+        size_type size() const {
+            return _values.size();
+        }
+        bool empty() const {
+            return _values.empty();
+        }
+        //Make room for n elements.
+        void reserve(size_type n) {
+            _values.reserve(n);
+            _back.reserve(n);
+            _slots.reserve(n);
+        }
+
+        bool contains(handle h) const {
+            return h.index < _slots.size() && _slots[h.index].generation == h.generation;
+        }
+        //Element of h, 0 if h is stale.
+        pointer get(handle h) {
+            return contains(h) ? &_values[_slots[h.index].dense] : 0;
+        }
+        const_pointer get(handle h) const {
+            return contains(h) ? &_values[_slots[h.index].dense] : 0;
+        }
+        reference at(handle h) {
+            if (!contains(h))
+                throw std::out_of_range("my_slot_map stale handle");
+            return _values[_slots[h.index].dense];
+        }
+        const_reference at(handle h) const {
+            if (!contains(h))
+                throw std::out_of_range("my_slot_map stale handle");
+            return _values[_slots[h.index].dense];
+        }
+        //Unchecked access, h must be live.
+        reference operator[](handle h) {
+            return _values[_slots[h.index].dense];
+        }
+        const_reference operator[](handle h) const {
+            return _values[_slots[h.index].dense];
+        }
+        //Handle of the element at dense position i.
+        handle handle_of(size_type i) const {
+            uint32_t s = _back[i];
+            return handle(s, _slots[s].generation);
+        }
+
+        //Operations.
+        handle insert(const value_type& value) {
+            uint32_t s = take_slot();
+            _values.push_back(value);
+            return bind(s);
+        }
+        handle insert(value_type&& value) {
+            uint32_t s = take_slot();
+            _values.push_back(mystl::move(value));
+            return bind(s);
+        }
+        //Erase the element of h by moving the last element into its place.
+        //Return false if h is stale.
+        bool erase(handle h) {
+            if (!contains(h))
+                return false;
+            uint32_t d = _slots[h.index].dense;
+            uint32_t last = (uint32_t)_values.size() - 1;
+            if (d != last) {
+                _values[d] = mystl::move(_values[last]);
+                _back[d] = _back[last];
+                _slots[_back[d]].dense = d;
+            }
+            _values.pop_back();
+            _back.pop_back();
+            release_slot(h.index);
+            return true;
+        }
+        void clear() {
+            for (size_type i = 0; i < _back.size(); ++i)
+                release_slot(_back[i]);
+            _values.clear();
+            _back.clear();
+        }
+        void swap(slot_map& x) {
+            _values.swap(x._values);
+            _back.swap(x._back);
+            _slots.swap(x._slots);
+            mystl::swap(_free, x._free);
+        }
+    private:
+        static const uint32_t end_of_free = (uint32_t)-1;
+
+        //dense is the value position while the slot is used, and the next
+        //free slot while it is not.
+        class slot {
+        public:
+            uint32_t dense;
+            uint32_t generation;
+        };
+
+        vector<value_type> _values;
+        //Slot of each value.
+        vector<uint32_t> _back;
+        vector<slot> _slots;
+        uint32_t _free;
+
+        uint32_t take_slot() {
+            if (_values.size() >= (size_type)end_of_free)
+                throw std::length_error("my_slot_map too many elements");
+            if (_free != end_of_free)
+                return _free;
+            slot s;
+            s.dense = end_of_free;
+            s.generation = 0;
+            _slots.push_back(s);
+            _free = (uint32_t)_slots.size() - 1;
+            return _free;
+        }
+        //Give slot s to the value just pushed.
+        handle bind(uint32_t s) {
+            _free = _slots[s].dense;
+            _slots[s].dense = (uint32_t)_values.size() - 1;
+            _back.push_back(s);
+            return handle(s, _slots[s].generation);
+        }
+        void release_slot(uint32_t s) {
+            ++_slots[s].generation;
+            _slots[s].dense = _free;
+            _free = s;
+        }
+    };
+
+    template<class T>
+    void swap(slot_map<T>& l, slot_map<T>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
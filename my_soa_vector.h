@@ -0,0 +1,422 @@
+#ifndef MY_SOA_VECTOR_H
+#define MY_SOA_VECTOR_H
+
+#include <stddef.h>
+#include <tuple>
+#include <utility>
+#include "my_memory"
+#include "my_algobase.h"
+#include "my_iterator.h"
+#include "my_vector.h"
+
+namespace mystl {
+
+    //Non-owning view of one column, contiguous and aligned for SIMD kernels.
+    template<class T>
+    class column_span {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T& reference;
+        typedef T* iterator;
+        typedef size_t size_type;
+
+        column_span(): _data(0), _size(0) {}
+        column_span(pointer p, size_type n): _data(p), _size(n) {}
+
+        pointer data() const {
+            return _data;
+        }
+        size_type size() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        iterator begin() const {
+            return _data;
+        }
+        iterator end() const {
+            return _data + _size;
+        }
+        reference operator[](size_type n) const {
+            return _data[n];
+        }
+    private:
+        pointer _data;
+        size_type _size;
+    };
+
+    //Per-column operations, unrolled at compile time from column I to N.
+    template<size_t I, size_t N>
+    class _soa_columns {
+    public:
+        //Bytes needed for n rows of columns [I, N), each padded to Align.
+        template<class Tuple, size_t Align>
+        static size_t bytes(size_t n) {
+            typedef typename std::tuple_element<I, Tuple>::type field;
+            return _round_up(n * sizeof(field), Align) + _soa_columns<I + 1, N>::template bytes<Tuple, Align>(n);
+        }
+        //Point every column into an aligned block of n rows.
+        template<class Ptrs, size_t Align>
+        static void layout(Ptrs& cols, char* base, size_t n) {
+            typedef typename std::tuple_element<I, Ptrs>::type field_pointer;
+            std::get<I>(cols) = reinterpret_cast<field_pointer>(base);
+            base += _round_up(n * sizeof(*std::get<I>(cols)), Align);
+            _soa_columns<I + 1, N>::template layout<Ptrs, Align>(cols, base, n);
+        }
+        //Whether a reallocation moves every column, see _relocate_by_move.
+        template<class Tuple>
+        static constexpr bool by_move() {
+            return _relocate_by_move<typename std::tuple_element<I, Tuple>::type>::value
+                && _soa_columns<I + 1, N>::template by_move<Tuple>();
+        }
+        //Construct rows [0, n) of every column in new storage from src,
+        //moved with true_type and copied with false_type. If a column
+        //throws, the columns already constructed are destroyed.
+        template<class Ptrs, class Move>
+        static void relocate(Ptrs& des, const Ptrs& src, size_t n, Move move) {
+            _uninitialized_relocate(std::get<I>(src), std::get<I>(src) + n, std::get<I>(des), move);
+            try {
+                _soa_columns<I + 1, N>::relocate(des, src, n, move);
+            } catch (...) {
+                for (size_t i = 0; i < n; ++i)
+                    _destroy(std::get<I>(des) + i);
+                throw;
+            }
+        }
+        //Destroy rows [first, last) of every column.
+        template<class Ptrs>
+        static void destroy(Ptrs& cols, size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+                _destroy(std::get<I>(cols) + i);
+            _soa_columns<I + 1, N>::destroy(cols, first, last);
+        }
+        //Construct row n from a tuple.
+        template<class Ptrs, class Tuple>
+        static void construct(Ptrs& cols, size_t n, const Tuple& value) {
+            _construct(std::get<I>(cols) + n, std::get<I>(value));
+            _soa_columns<I + 1, N>::construct(cols, n, value);
+        }
+        //Assign row n from a tuple.
+        template<class Ptrs, class Tuple>
+        static void assign(Ptrs& cols, size_t n, const Tuple& value) {
+            std::get<I>(cols)[n] = std::get<I>(value);
+            _soa_columns<I + 1, N>::assign(cols, n, value);
+        }
+        //Gather row n into a tuple.
+        template<class Ptrs, class Tuple>
+        static void load(const Ptrs& cols, size_t n, Tuple& value) {
+            std::get<I>(value) = std::get<I>(cols)[n];
+            _soa_columns<I + 1, N>::load(cols, n, value);
+        }
+
+        static size_t _round_up(size_t n, size_t align) {
+            return (n + align - 1) & ~(align - 1);
+        }
+    };
+    template<size_t N>
+    class _soa_columns<N, N> {
+    public:
+        template<class Tuple, size_t Align>
+        static size_t bytes(size_t) { return 0; }
+        template<class Ptrs, size_t Align>
+        static void layout(Ptrs&, char*, size_t) {}
+        template<class Tuple>
+        static constexpr bool by_move() { return true; }
+        template<class Ptrs, class Move>
+        static void relocate(Ptrs&, const Ptrs&, size_t, Move) {}
+        template<class Ptrs>
+        static void destroy(Ptrs&, size_t, size_t) {}
+        template<class Ptrs, class Tuple>
+        static void construct(Ptrs&, size_t, const Tuple&) {}
+        template<class Ptrs, class Tuple>
+        static void assign(Ptrs&, size_t, const Tuple&) {}
+        template<class Ptrs, class Tuple>
+        static void load(const Ptrs&, size_t, Tuple&) {}
+    };
+
+    //Structure of arrays: every field is stored in its own contiguous, aligned column.
+    template<class... Fields>
+    class soa_vector {
+    public:
+        typedef allocator<char> allocator_type;
+        typedef std::tuple<Fields...> value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        static const size_type column_count = sizeof...(Fields);
+        static const size_type column_alignment = 64;
+
+        //Type of column I.
+        template<size_type I>
+        class column_type {
+        public:
+            typedef typename std::tuple_element<I, value_type>::type type;
+        };
+
+        //Proxy for one row. Reads like a struct through get<I>().
+        template<class Vector>
+        class row {
+        public:
+            row(Vector* v, size_type n): _v(v), _n(n) {}
+
+            template<size_type I>
+            auto get() const -> decltype(std::declval<Vector&>().template column<I>()[0]) {
+                return _v->template column<I>()[_n];
+            }
+            operator value_type() const {
+                value_type value;
+                _soa_columns<0, column_count>::load(_v->_cols, _n, value);
+                return value;
+            }
+            const row& operator=(const value_type& value) const {
+                _soa_columns<0, column_count>::assign(_v->_cols, _n, value);
+                return *this;
+            }
+        private:
+            Vector* _v;
+            size_type _n;
+        };
+        typedef row<soa_vector> reference;
+        typedef row<const soa_vector> const_reference;
+
+        //Random access iterator yielding row proxies.
+        template<class Vector>
+        class row_iterator: public mystl::iterator<random_access_iterator_tag, value_type,
+                difference_type, void, row<Vector> > {
+        public:
+            row_iterator(): _v(0), _n(0) {}
+            row_iterator(Vector* v, size_type n): _v(v), _n(n) {}
+
+            row<Vector> operator*() const {
+                return row<Vector>(_v, _n);
+            }
+            row<Vector> operator[](difference_type n) const {
+                return row<Vector>(_v, _n + n);
+            }
+            row_iterator& operator++() {
+                ++_n;
+                return *this;
+            }
+            row_iterator operator++(int) {
+                row_iterator temp(*this);
+                ++_n;
+                return temp;
+            }
+            row_iterator& operator--() {
+                --_n;
+                return *this;
+            }
+            row_iterator operator--(int) {
+                row_iterator temp(*this);
+                --_n;
+                return temp;
+            }
+            row_iterator& operator+=(difference_type n) {
+                _n += n;
+                return *this;
+            }
+            row_iterator& operator-=(difference_type n) {
+                _n -= n;
+                return *this;
+            }
+            row_iterator operator+(difference_type n) const {
+                return row_iterator(_v, _n + n);
+            }
+            row_iterator operator-(difference_type n) const {
+                return row_iterator(_v, _n - n);
+            }
+            difference_type operator-(const row_iterator& x) const {
+                return difference_type(_n) - difference_type(x._n);
+            }
+            bool operator==(const row_iterator& x) const {
+                return _n == x._n;
+            }
+            bool operator!=(const row_iterator& x) const {
+                return _n != x._n;
+            }
+            bool operator<(const row_iterator& x) const {
+                return _n < x._n;
+            }
+            //Row index, for reaching into columns directly.
+            size_type index() const {
+                return _n;
+            }
+        private:
+            Vector* _v;
+            size_type _n;
+        };
+        typedef row_iterator<soa_vector> iterator;
+        typedef row_iterator<const soa_vector> const_iterator;
+
+        //Constructors.
+        soa_vector(): _size(0), _capacity(0), _block(0), _block_bytes(0) {}
+        soa_vector(const soa_vector& v): _size(0), _capacity(0), _block(0), _block_bytes(0) {
+            extend_space(v._size);
+            try {
+                _soa_columns<0, column_count>::relocate(_cols, v._cols, v._size, false_type());
+            } catch (...) {
+                _allocator.deallocate(_block, _block_bytes);
+                throw;
+            }
+            _size = v._size;
+        }
+        //Destructor.
+        ~soa_vector() {
+            clear();
+            if (0 != _block)
+                _allocator.deallocate(_block, _block_bytes);
+        }
+
+        soa_vector& operator=(const soa_vector& v) {
+            if (this != &v) {
+                soa_vector temp(v);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        //Data access.
+        iterator begin() {
+            return iterator(this, 0);
+        }
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+        iterator end() {
+            return iterator(this, _size);
+        }
+        const_iterator end() const {
+            return const_iterator(this, _size);
+        }
+        reference operator[](size_type n) {
+            return reference(this, n);
+        }
+        const_reference operator[](size_type n) const {
+            return const_reference(this, n);
+        }
+        //Raw pointer to column I, aligned to column_alignment.
+        template<size_type I>
+        typename column_type<I>::type* column() {
+            return std::get<I>(_cols);
+        }
+        template<size_type I>
+        const typename column_type<I>::type* column() const {
+            return std::get<I>(_cols);
+        }
+        //Span over the live rows of column I.
+        template<size_type I>
+        column_span<typename column_type<I>::type> span() {
+            return column_span<typename column_type<I>::type>(std::get<I>(_cols), _size);
+        }
+        template<size_type I>
+        column_span<const typename column_type<I>::type> span() const {
+            return column_span<const typename column_type<I>::type>(std::get<I>(_cols), _size);
+        }
+
+        size_type size() const {
+            return _size;
+        }
+        size_type capacity() const {
+            return _capacity;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+
+        //Operations.
+        void push_back(const value_type& value) {
+            if (_size == _capacity)
+                auto_extend_space(_capacity + 1);
+            _soa_columns<0, column_count>::construct(_cols, _size, value);
+            ++_size;
+        }
+        void push_back(const Fields&... fields) {
+            push_back(value_type(fields...));
+        }
+        void pop_back() {
+            if (!empty()) {
+                _soa_columns<0, column_count>::destroy(_cols, _size - 1, _size);
+                --_size;
+            }
+        }
+        void resize(size_type n, const value_type& value = value_type()) {
+            if (n <= _size) {
+                _soa_columns<0, column_count>::destroy(_cols, n, _size);
+            } else {
+                if (n > _capacity)
+                    auto_extend_space(n);
+                for (size_type i = _size; i < n; ++i)
+                    _soa_columns<0, column_count>::construct(_cols, i, value);
+            }
+            _size = n;
+        }
+        void reserve(size_type n) {
+            if (n > _capacity)
+                extend_space(n);
+        }
+        void clear() {
+            _soa_columns<0, column_count>::destroy(_cols, 0, _size);
+            _size = 0;
+        }
+        void swap(soa_vector& x) {
+            mystl::swap(_size, x._size);
+            mystl::swap(_capacity, x._capacity);
+            mystl::swap(_cols, x._cols);
+            mystl::swap(_block, x._block);
+            mystl::swap(_block_bytes, x._block_bytes);
+        }
+    private:
+        typedef std::tuple<Fields*...> pointers;
+
+        size_type _size;
+        size_type _capacity;
+        //All columns live in one block, each starting on a column_alignment boundary.
+        pointers _cols;
+        char* _block;
+        size_type _block_bytes;
+        allocator_type _allocator;
+
+        //Columns are moved on reallocation only if none of them can throw,
+        //so a failing copy never leaves an earlier column moved from.
+        typedef integral_constant<bool, _soa_columns<0, column_count>::template by_move<value_type>()>
+            relocate_tag;
+
+        void auto_extend_space(size_type required) {
+            extend_space(_grown_capacity(_capacity, required));
+        }
+        //Relocate every column into a new block of n rows. If that throws,
+        //the new block is freed and the vector is left as it was.
+        void extend_space(size_type n) {
+            size_type bytes = _soa_columns<0, column_count>::template bytes<value_type, column_alignment>(n)
+                + column_alignment;
+            char* block = _allocator.allocate(bytes);
+            size_t misalign = reinterpret_cast<size_t>(block) & (column_alignment - 1);
+            char* base = block + (misalign ? column_alignment - misalign : 0);
+            pointers cols;
+            _soa_columns<0, column_count>::template layout<pointers, column_alignment>(cols, base, n);
+            if (0 != _block) {
+                try {
+                    _soa_columns<0, column_count>::relocate(cols, _cols, _size, relocate_tag());
+                } catch (...) {
+                    _allocator.deallocate(block, bytes);
+                    throw;
+                }
+                _soa_columns<0, column_count>::destroy(_cols, 0, _size);
+                _allocator.deallocate(_block, _block_bytes);
+            }
+            _cols = cols;
+            _block = block;
+            _block_bytes = bytes;
+            _capacity = n;
+        }
+    };
+
+    template<class... Fields>
+    void swap(soa_vector<Fields...>& l, soa_vector<Fields...>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
@@ -0,0 +1,454 @@
+#ifndef MY_STRING_H
+#define MY_STRING_H
+
+#include <stddef.h>
+#include <stdexcept>
+#include "my_memory"
+#include "my_algobase.h"
+#include "my_iterator.h"
+#include "my_string_view.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "my_string.h short string layout assumes a little endian target"
+#endif
+
+namespace mystl {
+
+    //String with small string optimization.
+    //Short strings live inside the object itself: 23 chars for char on 64-bit.
+    template<class CharT, class Alloc = allocator<CharT> >
+    class basic_string {
+    public:
+        typedef Alloc allocator_type;
+        typedef CharT value_type;
+        typedef CharT& reference;
+        typedef const CharT& const_reference;
+        typedef CharT* pointer;
+        typedef const CharT* const_pointer;
+        typedef CharT* iterator;
+        typedef const CharT* const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef char_traits<CharT> traits_type;
+        typedef basic_string_view<CharT> view_type;
+
+        static const size_type npos = (size_type)-1;
+
+        //Constructors.
+        explicit basic_string(const allocator_type& alloc = allocator_type()): _impl(alloc) {
+            set_short_size(0);
+        }
+        basic_string(const CharT* s, const allocator_type& alloc = allocator_type()): _impl(alloc) {
+            init(s, traits_type::length(s));
+        }
+        basic_string(const CharT* s, size_type n, const allocator_type& alloc = allocator_type()):
+            _impl(alloc) {
+            init(s, n);
+        }
+        basic_string(size_type n, CharT c, const allocator_type& alloc = allocator_type()):
+            _impl(alloc) {
+            set_short_size(0);
+            append(n, c);
+        }
+        explicit basic_string(view_type v, const allocator_type& alloc = allocator_type()):
+            _impl(alloc) {
+            init(v.data(), v.size());
+        }
+        basic_string(const basic_string& s): _impl(s._impl) {
+            init(s.data(), s.size());
+        }
+        basic_string(basic_string&& s): _impl(s._impl) {
+            s.set_short_size(0);
+        }
+        //Destructor.
+        ~basic_string() {
+            if (is_long())
+                _impl.deallocate(_impl.r.l.data, long_capacity() + 1);
+        }
+
+        basic_string& operator=(const basic_string& s) {
+            if (this != &s)
+                assign(s.data(), s.size());
+            return *this;
+        }
+        basic_string& operator=(basic_string&& s) {
+            if (this != &s) {
+                swap(s);
+                s.clear();
+            }
+            return *this;
+        }
+        basic_string& operator=(const CharT* s) {
+            return assign(s, traits_type::length(s));
+        }
+        basic_string& operator=(view_type v) {
+            return assign(v.data(), v.size());
+        }
+
+        //Data access.
+        iterator begin() {
+            return data();
+        }
+        const_iterator begin() const {
+            return data();
+        }
+        iterator end() {
+            return data() + size();
+        }
+        const_iterator end() const {
+            return data() + size();
+        }
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        pointer data() {
+            return is_long() ? _impl.r.l.data : _impl.r.s;
+        }
+        const_pointer data() const {
+            return is_long() ? _impl.r.l.data : _impl.r.s;
+        }
+        const_pointer c_str() const {
+            return data();
+        }
+        size_type size() const {
+            return is_long() ? _impl.r.l.size : short_capacity - size_type(_impl.r.s[short_capacity]);
+        }
+        size_type length() const {
+            return size();
+        }
+        size_type capacity() const {
+            return is_long() ? long_capacity() : short_capacity;
+        }
+        size_type max_size() const {
+            return _impl.max_size() - 1;
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+        reference operator[](size_type n) {
+            return data()[n];
+        }
+        const_reference operator[](size_type n) const {
+            return data()[n];
+        }
+        reference at(size_type n) {
+            if (n >= size())
+                throw std::out_of_range("my_string access out of range");
+            return data()[n];
+        }
+        const_reference at(size_type n) const {
+            if (n >= size())
+                throw std::out_of_range("my_string access out of range");
+            return data()[n];
+        }
+        reference front() {
+            return data()[0];
+        }
+        const_reference front() const {
+            return data()[0];
+        }
+        reference back() {
+            return data()[size() - 1];
+        }
+        const_reference back() const {
+            return data()[size() - 1];
+        }
+        operator view_type() const {
+            return view_type(data(), size());
+        }
+        allocator_type& get_allocator() {
+            return _impl;
+        }
+
+        //Size changes.
+        void reserve(size_type n) {
+            if (n > capacity())
+                grow_exact(n);
+        }
+        void resize(size_type n, CharT c = CharT()) {
+            size_type old = size();
+            if (n > old)
+                append(n - old, c);
+            else
+                set_size(n);
+        }
+        void clear() {
+            set_size(0);
+        }
+        void push_back(CharT c) {
+            size_type n = size();
+            if (n == capacity())
+                grow(n + 1);
+            data()[n] = c;
+            set_size(n + 1);
+        }
+        void pop_back() {
+            set_size(size() - 1);
+        }
+
+        //Modifiers.
+        basic_string& assign(const CharT* s, size_type n) {
+            if (n > capacity())
+                grow_exact(n);
+            traits_type::move(data(), s, n);
+            set_size(n);
+            return *this;
+        }
+        basic_string& append(const CharT* s, size_type n) {
+            size_type old = size();
+            if (old + n > capacity()) {
+                //s may point into this string, copy before the buffer moves.
+                basic_string temp(s, n);
+                grow(old + n);
+                traits_type::copy(data() + old, temp.data(), n);
+            } else {
+                traits_type::move(data() + old, s, n);
+            }
+            set_size(old + n);
+            return *this;
+        }
+        basic_string& append(size_type n, CharT c) {
+            size_type old = size();
+            if (old + n > capacity())
+                grow(old + n);
+            traits_type::assign(data() + old, n, c);
+            set_size(old + n);
+            return *this;
+        }
+        basic_string& append(view_type v) {
+            return append(v.data(), v.size());
+        }
+        basic_string& operator+=(view_type v) {
+            return append(v.data(), v.size());
+        }
+        basic_string& operator+=(const basic_string& s) {
+            return append(s.data(), s.size());
+        }
+        basic_string& operator+=(const CharT* s) {
+            return append(s, traits_type::length(s));
+        }
+        basic_string& operator+=(CharT c) {
+            push_back(c);
+            return *this;
+        }
+        //Insert v before pos.
+        basic_string& insert(size_type pos, view_type v) {
+            size_type old = size();
+            if (pos > old)
+                throw std::out_of_range("my_string insert out of range");
+            basic_string temp(v);
+            if (old + v.size() > capacity())
+                grow(old + v.size());
+            CharT* p = data();
+            traits_type::move(p + pos + v.size(), p + pos, old - pos);
+            traits_type::copy(p + pos, temp.data(), v.size());
+            set_size(old + v.size());
+            return *this;
+        }
+        //Erase n characters from pos.
+        basic_string& erase(size_type pos = 0, size_type n = npos) {
+            size_type old = size();
+            if (pos > old)
+                throw std::out_of_range("my_string erase out of range");
+            if (n > old - pos)
+                n = old - pos;
+            CharT* p = data();
+            traits_type::move(p + pos, p + pos + n, old - pos - n);
+            set_size(old - n);
+            return *this;
+        }
+        void swap(basic_string& s) {
+            mystl::swap(_impl, s._impl);
+        }
+
+        //Search and compare, shared with string_view.
+        basic_string substr(size_type pos = 0, size_type n = npos) const {
+            return basic_string(view_type(*this).substr(pos, n));
+        }
+        size_type find(CharT c, size_type pos = 0) const {
+            return view_type(*this).find(c, pos);
+        }
+        size_type find(view_type v, size_type pos = 0) const {
+            return view_type(*this).find(v, pos);
+        }
+        size_type find(const CharT* s, size_type pos = 0) const {
+            return view_type(*this).find(view_type(s), pos);
+        }
+        size_type rfind(CharT c, size_type pos = npos) const {
+            return view_type(*this).rfind(c, pos);
+        }
+        int compare(view_type v) const {
+            return view_type(*this).compare(v);
+        }
+        bool starts_with(view_type v) const {
+            return view_type(*this).starts_with(v);
+        }
+        bool ends_with(view_type v) const {
+            return view_type(*this).ends_with(v);
+        }
+    private:
+        class long_rep {
+        public:
+            pointer data;
+            size_type size;
+            //Top bit marks the long mode, it overlaps the last short character.
+            size_type cap;
+        };
+        union rep {
+            long_rep l;
+            //In short mode s[short_capacity] holds short_capacity - size,
+            //which doubles as the terminator when the buffer is full.
+            CharT s[sizeof(long_rep) / sizeof(CharT)];
+        };
+
+        static const size_type short_capacity = sizeof(long_rep) / sizeof(CharT) - 1;
+        static const size_type long_flag = (size_type)1 << (sizeof(size_type) * 8 - 1);
+
+        //Derives from the allocator so an empty one takes no space.
+        class impl: public allocator_type {
+        public:
+            impl(const allocator_type& alloc): allocator_type(alloc) {}
+            rep r;
+        };
+        impl _impl;
+
+        bool is_long() const {
+            return (_impl.r.l.cap & long_flag) != 0;
+        }
+        size_type long_capacity() const {
+            return _impl.r.l.cap & ~long_flag;
+        }
+        void set_short_size(size_type n) {
+            _impl.r.s[n] = CharT();
+            _impl.r.s[short_capacity] = CharT(short_capacity - n);
+        }
+        void set_size(size_type n) {
+            if (is_long()) {
+                _impl.r.l.size = n;
+                _impl.r.l.data[n] = CharT();
+            } else {
+                set_short_size(n);
+            }
+        }
+        void init(const CharT* s, size_type n) {
+            if (n <= short_capacity) {
+                traits_type::copy(_impl.r.s, s, n);
+                set_short_size(n);
+            } else {
+                pointer p = _impl.allocate(n + 1);
+                traits_type::copy(p, s, n);
+                _impl.r.l.data = p;
+                _impl.r.l.cap = n | long_flag;
+                _impl.r.l.size = n;
+                p[n] = CharT();
+            }
+        }
+        //Amortized growth for appends.
+        void grow(size_type required) {
+            size_type n = capacity() * 2;
+            grow_exact(n < required ? required : n);
+        }
+        //Move to a heap buffer holding n characters.
+        void grow_exact(size_type n) {
+            size_type old = size();
+            pointer p = _impl.allocate(n + 1);
+            traits_type::copy(p, data(), old + 1);
+            if (is_long())
+                _impl.deallocate(_impl.r.l.data, long_capacity() + 1);
+            _impl.r.l.data = p;
+            _impl.r.l.size = old;
+            _impl.r.l.cap = n | long_flag;
+        }
+    };
+
+    template<class CharT, class Alloc>
+    const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::npos;
+
+    typedef basic_string<char> string;
+    typedef basic_string<wchar_t> wstring;
+
+    //Hashes the same as the view of the string.
+    template<class CharT, class Alloc>
+    class hash<basic_string<CharT, Alloc> > {
+    public:
+        size_t operator()(const basic_string<CharT, Alloc>& s) const {
+            return _hash_bytes(s.data(), s.size() * sizeof(CharT));
+        }
+    };
+
+    template<class CharT, class Alloc>
+    basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& l, basic_string_view<CharT> r) {
+        basic_string<CharT, Alloc> temp;
+        temp.reserve(l.size() + r.size());
+        temp.append(l.data(), l.size());
+        temp.append(r);
+        return temp;
+    }
+    template<class CharT, class Alloc>
+    basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return l + basic_string_view<CharT>(r);
+    }
+    template<class CharT, class Alloc>
+    basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& l, const CharT* r) {
+        return l + basic_string_view<CharT>(r);
+    }
+
+    //Comparisons, also against views and C strings.
+    template<class CharT, class Alloc>
+    bool operator==(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return basic_string_view<CharT>(l) == basic_string_view<CharT>(r);
+    }
+    template<class CharT, class Alloc>
+    bool operator==(const basic_string<CharT, Alloc>& l, basic_string_view<CharT> r) {
+        return basic_string_view<CharT>(l) == r;
+    }
+    template<class CharT, class Alloc>
+    bool operator==(const basic_string<CharT, Alloc>& l, const CharT* r) {
+        return basic_string_view<CharT>(l) == basic_string_view<CharT>(r);
+    }
+    template<class CharT, class Alloc>
+    bool operator!=(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return !(l == r);
+    }
+    template<class CharT, class Alloc>
+    bool operator!=(const basic_string<CharT, Alloc>& l, basic_string_view<CharT> r) {
+        return !(l == r);
+    }
+    template<class CharT, class Alloc>
+    bool operator!=(const basic_string<CharT, Alloc>& l, const CharT* r) {
+        return !(l == r);
+    }
+    template<class CharT, class Alloc>
+    bool operator<(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return l.compare(r) < 0;
+    }
+    template<class CharT, class Alloc>
+    bool operator>(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return l.compare(r) > 0;
+    }
+    template<class CharT, class Alloc>
+    bool operator<=(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return l.compare(r) <= 0;
+    }
+    template<class CharT, class Alloc>
+    bool operator>=(const basic_string<CharT, Alloc>& l, const basic_string<CharT, Alloc>& r) {
+        return l.compare(r) >= 0;
+    }
+    template<class CharT, class Alloc>
+    void swap(basic_string<CharT, Alloc>& l, basic_string<CharT, Alloc>& r) {
+        l.swap(r);
+    }
+}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef MY_STRING_VIEW_H
+#define MY_STRING_VIEW_H
+
+#include <stddef.h>
+#include <string.h>
+#include <stdexcept>
+#include "my_iterator.h"
+#include "my_function.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mystl {
+
+    //Character operations used by strings.
+    template<class CharT>
+    class char_traits {
+    public:
+        typedef CharT char_type;
+
+        static size_t length(const char_type* s) {
+            size_t n = 0;
+            while (s[n] != char_type())
+                ++n;
+            return n;
+        }
+        static int compare(const char_type* l, const char_type* r, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                if (l[i] < r[i])
+                    return -1;
+                if (r[i] < l[i])
+                    return 1;
+            }
+            return 0;
+        }
+        static const char_type* find(const char_type* s, size_t n, char_type c) {
+            for (size_t i = 0; i < n; ++i) {
+                if (s[i] == c)
+                    return s + i;
+            }
+            return 0;
+        }
+        static void copy(char_type* des, const char_type* src, size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                des[i] = src[i];
+        }
+        static void move(char_type* des, const char_type* src, size_t n) {
+            if (des < src)
+                copy(des, src, n);
+            else
+                for (size_t i = n; i > 0; --i)
+                    des[i - 1] = src[i - 1];
+        }
+        static void assign(char_type* des, size_t n, char_type c) {
+            for (size_t i = 0; i < n; ++i)
+                des[i] = c;
+        }
+    };
+
+    //char goes through libc, which is vectorized.
+    template<>
+    class char_traits<char> {
+    public:
+        typedef char char_type;
+
+        static size_t length(const char* s) {
+            return strlen(s);
+        }
+        static int compare(const char* l, const char* r, size_t n) {
+            return n == 0 ? 0 : memcmp(l, r, n);
+        }
+        static const char* find(const char* s, size_t n, char c) {
+            return n == 0 ? 0 : static_cast<const char*>(memchr(s, c, n));
+        }
+        static void copy(char* des, const char* src, size_t n) {
+            if (n)
+                memcpy(des, src, n);
+        }
+        static void move(char* des, const char* src, size_t n) {
+            if (n)
+                memmove(des, src, n);
+        }
+        static void assign(char* des, size_t n, char c) {
+            if (n)
+                memset(des, c, n);
+        }
+    };
+
+    //Position of needle in haystack, or (size_t)-1.
+    //Generic version: scan for the first character, then compare the rest.
+    template<class CharT>
+    size_t _search(const CharT* s, size_t n, const CharT* needle, size_t m) {
+        if (m == 0)
+            return 0;
+        const CharT* p = s;
+        const CharT* last = s + n;
+        while (size_t(last - p) >= m) {
+            p = char_traits<CharT>::find(p, (last - p) - m + 1, needle[0]);
+            if (0 == p)
+                break;
+            if (char_traits<CharT>::compare(p + 1, needle + 1, m - 1) == 0)
+                return p - s;
+            ++p;
+        }
+        return (size_t)-1;
+    }
+    //char version: with SSE2, compare the first and last needle bytes against
+    //16 candidate positions at once, and memcmp only where both match.
+    inline size_t _search(const char* s, size_t n, const char* needle, size_t m) {
+        if (m == 0)
+            return 0;
+        if (m > n)
+            return (size_t)-1;
+        if (m == 1) {
+            const char* p = char_traits<char>::find(s, n, needle[0]);
+            return p ? size_t(p - s) : (size_t)-1;
+        }
+        size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[m - 1]);
+        for ( ; i + m + 15 <= n; i += 16) {
+            __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first),
+                    _mm_cmpeq_epi8(last, block_last)));
+            while (mask) {
+                unsigned bit = __builtin_ctz(mask);
+                if (memcmp(s + i + bit + 1, needle + 1, m - 2) == 0)
+                    return i + bit;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        size_t found = _search<char>(s + i, n - i, needle, m);
+        return found == (size_t)-1 ? found : i + found;
+    }
+
+    //Non-owning view of a character sequence.
+    template<class CharT>
+    class basic_string_view {
+    public:
+        typedef CharT value_type;
+        typedef const CharT* pointer;
+        typedef const CharT* const_pointer;
+        typedef const CharT& reference;
+        typedef const CharT& const_reference;
+        typedef const CharT* iterator;
+        typedef const CharT* const_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef char_traits<CharT> traits_type;
+
+        static const size_type npos = (size_type)-1;
+
+        //Constructors.
+        basic_string_view(): _data(0), _size(0) {}
+        basic_string_view(const CharT* s): _data(s), _size(traits_type::length(s)) {}
+        basic_string_view(const CharT* s, size_type n): _data(s), _size(n) {}
+
+        //Data access.
+        const_iterator begin() const {
+            return _data;
+        }
+        const_iterator end() const {
+            return _data + _size;
+        }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        const_pointer data() const {
+            return _data;
+        }
+        size_type size() const {
+            return _size;
+        }
+        size_type length() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+        const_reference operator[](size_type n) const {
+            return _data[n];
+        }
+        const_reference at(size_type n) const {
+            if (n >= _size)
+                throw std::out_of_range("my_string_view access out of range");
+            return _data[n];
+        }
+        const_reference front() const {
+            return _data[0];
+        }
+        const_reference back() const {
+            return _data[_size - 1];
+        }
+
+        //Operations.
+        void remove_prefix(size_type n) {
+            _data += n;
+            _size -= n;
+        }
+        void remove_suffix(size_type n) {
+            _size -= n;
+        }
+        basic_string_view substr(size_type pos, size_type n = npos) const {
+            if (pos > _size)
+                throw std::out_of_range("my_string_view substr out of range");
+            if (n > _size - pos)
+                n = _size - pos;
+            return basic_string_view(_data + pos, n);
+        }
+        int compare(basic_string_view x) const {
+            size_type n = _size < x._size ? _size : x._size;
+            int r = traits_type::compare(_data, x._data, n);
+            if (r != 0)
+                return r;
+            return _size < x._size ? -1 : (_size > x._size ? 1 : 0);
+        }
+        bool starts_with(basic_string_view x) const {
+            return _size >= x._size && traits_type::compare(_data, x._data, x._size) == 0;
+        }
+        bool ends_with(basic_string_view x) const {
+            return _size >= x._size && traits_type::compare(_data + _size - x._size, x._data, x._size) == 0;
+        }
+        //Find a character from pos.
+        size_type find(CharT c, size_type pos = 0) const {
+            if (pos >= _size)
+                return npos;
+            const CharT* p = traits_type::find(_data + pos, _size - pos, c);
+            return p ? size_type(p - _data) : npos;
+        }
+        //Find a substring from pos.
+        size_type find(basic_string_view x, size_type pos = 0) const {
+            if (pos > _size)
+                return npos;
+            size_type r = _search(_data + pos, _size - pos, x._data, x._size);
+            return r == npos ? npos : r + pos;
+        }
+        //Find the last occurrence of a character at or before pos.
+        size_type rfind(CharT c, size_type pos = npos) const {
+            if (_size == 0)
+                return npos;
+            if (pos >= _size)
+                pos = _size - 1;
+            for (size_type i = pos + 1; i > 0; --i) {
+                if (_data[i - 1] == c)
+                    return i - 1;
+            }
+            return npos;
+        }
+    private:
+        const CharT* _data;
+        size_type _size;
+    };
+
+    template<class CharT>
+    const typename basic_string_view<CharT>::size_type basic_string_view<CharT>::npos;
+
+    typedef basic_string_view<char> string_view;
+    typedef basic_string_view<wchar_t> wstring_view;
+
+    template<class CharT>
+    class hash<basic_string_view<CharT> > {
+    public:
+        size_t operator()(basic_string_view<CharT> s) const {
+            return _hash_bytes(s.data(), s.size() * sizeof(CharT));
+        }
+    };
+
+    template<class CharT>
+    bool operator==(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return l.size() == r.size() && char_traits<CharT>::compare(l.data(), r.data(), l.size()) == 0;
+    }
+    template<class CharT>
+    bool operator!=(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return !(l == r);
+    }
+    template<class CharT>
+    bool operator<(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return l.compare(r) < 0;
+    }
+    template<class CharT>
+    bool operator>(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return l.compare(r) > 0;
+    }
+    template<class CharT>
+    bool operator<=(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return l.compare(r) <= 0;
+    }
+    template<class CharT>
+    bool operator>=(basic_string_view<CharT> l, basic_string_view<CharT> r) {
+        return l.compare(r) >= 0;
+    }
+}
+
+#endif
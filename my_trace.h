@@ -0,0 +1,366 @@
+#ifndef MY_TRACE_H
+#define MY_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <thread>
+#include "my_allocator.h"
+
+namespace mystl {
+
+    //Operations the containers report.
+    enum trace_op {
+        trace_reallocate,
+        trace_node_alloc,
+        trace_erase_shift,
+        trace_op_count
+    };
+    inline const char* trace_op_name(trace_op op) {
+        static const char* const names[trace_op_count] = {
+            "reallocate", "node_alloc", "erase_shift"
+        };
+        return names[op];
+    }
+
+    //Time stamp counter, steady clock nanoseconds where there is none.
+    inline uint64_t _read_tsc() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_ia32_rdtsc();
+#else
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+    //Index of the highest set bit, v must not be 0.
+    inline unsigned _log2(uint64_t v) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(v);
+#else
+        unsigned n = 0;
+        while (v >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    //Log-linear latency histogram in the style of HDR histograms.
+    //Each power of two range is split into 16 equal buckets, so any value is
+    //known to within 1/16 over the whole 64 bit range in under 8 KB.
+    class latency_histogram {
+    public:
+        static const unsigned sub_bits = 4;
+        static const size_t sub_count = (size_t)1 << sub_bits;
+        static const size_t bucket_count = (64 - sub_bits + 1) * sub_count;
+
+        latency_histogram() {
+            reset();
+        }
+
+        static size_t bucket_of(uint64_t v) {
+            if (v < sub_count)
+                return (size_t)v;
+            unsigned shift = _log2(v) - sub_bits;
+            return (shift + 1) * sub_count + (size_t)((v >> shift) & (sub_count - 1));
+        }
+        //Lowest value of bucket i.
+        static uint64_t bucket_value(size_t i) {
+            if (i < sub_count)
+                return i;
+            unsigned shift = (unsigned)(i / sub_count) - 1;
+            return (uint64_t)(sub_count + i % sub_count) << shift;
+        }
+
+        void record(uint64_t v) {
+            ++_counts[bucket_of(v)];
+            ++_total;
+        }
+        void add(size_t bucket, uint64_t n) {
+            _counts[bucket] += n;
+            _total += n;
+        }
+        void merge(const latency_histogram& x) {
+            for (size_t i = 0; i < bucket_count; ++i)
+                _counts[i] += x._counts[i];
+            _total += x._total;
+        }
+        void reset() {
+            for (size_t i = 0; i < bucket_count; ++i)
+                _counts[i] = 0;
+            _total = 0;
+        }
+        uint64_t count() const {
+            return _total;
+        }
+        uint64_t count(size_t bucket) const {
+            return _counts[bucket];
+        }
+        //Smallest bucket value at or above fraction q (0 to 1) of the values.
+        uint64_t percentile(double q) const {
+            uint64_t want = (uint64_t)(q * _total);
+            if (want == 0)
+                want = 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < bucket_count; ++i) {
+                seen += _counts[i];
+                if (seen >= want)
+                    return bucket_value(i);
+            }
+            return 0;
+        }
+    private:
+        uint64_t _counts[bucket_count];
+        uint64_t _total;
+    };
+
+    //Events and histograms of one thread. Only the owner writes, with plain
+    //relaxed stores and no locked instruction; a dump may read at any time.
+    //The ring keeps the latest capacity events.
+    class alignas(64) trace_buffer {
+    public:
+        static const size_t capacity = 4096;
+
+        std::atomic<bool> in_use;
+        unsigned id;
+        trace_buffer* next;
+
+        explicit trace_buffer(unsigned i): in_use(true), id(i), next(0), _head(0) {
+            for (size_t k = 0; k < capacity; ++k) {
+                for (size_t w = 0; w < 3; ++w)
+                    _events[k][w].store(0, std::memory_order_relaxed);
+            }
+            for (size_t op = 0; op < trace_op_count; ++op) {
+                for (size_t b = 0; b < latency_histogram::bucket_count; ++b)
+                    _counts[op][b].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        //weight is the number of ops the event stands for in the histogram.
+        void record(trace_op op, uint64_t start, uint64_t ticks, uint64_t detail, unsigned weight = 1) {
+            uint64_t h = _head.load(std::memory_order_relaxed);
+            std::atomic<uint64_t>* e = _events[h & (capacity - 1)];
+            e[0].store(start, std::memory_order_relaxed);
+            e[1].store((ticks & (((uint64_t)1 << 56) - 1)) | ((uint64_t)op << 56), std::memory_order_relaxed);
+            e[2].store(detail, std::memory_order_relaxed);
+            _head.store(h + 1, std::memory_order_release);
+            std::atomic<uint64_t>& c = _counts[op][latency_histogram::bucket_of(ticks)];
+            c.store(c.load(std::memory_order_relaxed) + weight, std::memory_order_relaxed);
+        }
+        void add_to(trace_op op, latency_histogram& h) const {
+            for (size_t b = 0; b < latency_histogram::bucket_count; ++b) {
+                uint64_t n = _counts[op][b].load(std::memory_order_relaxed);
+                if (n != 0)
+                    h.add(b, n);
+            }
+        }
+        //Call f(op, start, ticks, detail) for the events still in the ring.
+        //Events overwritten while they were read are skipped.
+        template<class Function>
+        void for_each(Function f) const {
+            uint64_t h = _head.load(std::memory_order_acquire);
+            uint64_t i = h > capacity ? h - capacity : 0;
+            for ( ; i < h; ++i) {
+                const std::atomic<uint64_t>* e = _events[i & (capacity - 1)];
+                uint64_t start = e[0].load(std::memory_order_relaxed);
+                uint64_t word = e[1].load(std::memory_order_relaxed);
+                uint64_t detail = e[2].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_head.load(std::memory_order_relaxed) - i > capacity)
+                    continue;
+                f((trace_op)(word >> 56), start, word & (((uint64_t)1 << 56) - 1), detail);
+            }
+        }
+    private:
+        std::atomic<uint64_t> _head;
+        std::atomic<uint64_t> _events[capacity][3];
+        std::atomic<uint64_t> _counts[trace_op_count][latency_histogram::bucket_count];
+    };
+
+    //All trace buffers of the process. A thread gets a buffer on its first
+    //event and gives it back on exit; the next new thread reuses it.
+    //Each thread keeps its buffer in one thread_local, so there is a single
+    //registry, reached through global().
+    class trace_registry {
+    public:
+        //Never destroyed: a thread may exit and give its buffer back after
+        //static destruction has begun, e.g. a detached worker.
+        static trace_registry& global() {
+            static trace_registry& registry = *new trace_registry;
+            return registry;
+        }
+
+        trace_buffer& local() {
+            static thread_local thread_slot slot;
+            if (0 == slot.buffer)
+                slot.buffer = acquire();
+            return *slot.buffer;
+        }
+        //Histogram of op over all threads, in ticks.
+        latency_histogram histogram(trace_op op) const {
+            latency_histogram h;
+            for (trace_buffer* b = _buffers.load(std::memory_order_acquire); b; b = b->next)
+                b->add_to(op, h);
+            return h;
+        }
+        //Ticks per microsecond, measured against the steady clock since the
+        //registry was made. Waits until 10 ms have passed for precision.
+        double ticks_per_us() const {
+            std::chrono::steady_clock::duration least = std::chrono::milliseconds(10);
+            std::chrono::steady_clock::duration passed = std::chrono::steady_clock::now() - _start_time;
+            if (passed < least)
+                std::this_thread::sleep_for(least - passed);
+            uint64_t ticks = _read_tsc() - _start_tsc;
+            double us = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - _start_time).count();
+            return ticks / us;
+        }
+        //Write the events in the rings as Chrome trace JSON, for
+        //chrome://tracing or Perfetto. Times are microseconds from start.
+        void dump_chrome_trace(std::ostream& out) const {
+            double scale = 1.0 / ticks_per_us();
+            out << "{\"traceEvents\":[";
+            bool first = true;
+            for (trace_buffer* b = _buffers.load(std::memory_order_acquire); b; b = b->next)
+                b->for_each(chrome_writer(out, first, b->id, _start_tsc, scale));
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        }
+    private:
+        class thread_slot {
+        public:
+            trace_buffer* buffer;
+
+            thread_slot(): buffer(0) {}
+            ~thread_slot() {
+                if (0 != buffer)
+                    buffer->in_use.store(false, std::memory_order_release);
+            }
+        };
+        class chrome_writer {
+        public:
+            chrome_writer(std::ostream& out, bool& first, unsigned tid, uint64_t start, double scale):
+                _out(&out), _first(&first), _tid(tid), _start(start), _scale(scale) {}
+            void operator()(trace_op op, uint64_t start, uint64_t ticks, uint64_t detail) const {
+                double ts = start > _start ? (start - _start) * _scale : 0.0;
+                *_out << (*_first ? "\n" : ",\n") << "{\"name\":\"" << trace_op_name(op)
+                    << "\",\"cat\":\"mystl\",\"ph\":\"X\",\"pid\":1,\"tid\":" << _tid
+                    << ",\"ts\":" << ts << ",\"dur\":" << ticks * _scale
+                    << ",\"args\":{\"n\":" << detail << "}}";
+                *_first = false;
+            }
+        private:
+            std::ostream* _out;
+            bool* _first;
+            unsigned _tid;
+            uint64_t _start;
+            double _scale;
+        };
+
+        std::atomic<trace_buffer*> _buffers;
+        std::atomic<unsigned> _count;
+        uint64_t _start_tsc;
+        std::chrono::steady_clock::time_point _start_time;
+        allocator<trace_buffer> buffer_allocator;
+
+        trace_registry(): _buffers(0), _count(0), _start_tsc(_read_tsc()),
+            _start_time(std::chrono::steady_clock::now()) {}
+        trace_registry(const trace_registry&);
+        trace_registry& operator=(const trace_registry&);
+
+        trace_buffer* acquire() {
+            for (trace_buffer* b = _buffers.load(std::memory_order_acquire); b; b = b->next) {
+                bool expected = false;
+                if (!b->in_use.load(std::memory_order_relaxed)
+                        && b->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return b;
+            }
+            trace_buffer* b = buffer_allocator.allocate(1);
+            new(b) trace_buffer(_count.fetch_add(1, std::memory_order_relaxed) + 1);
+            trace_buffer* head = _buffers.load(std::memory_order_relaxed);
+            do {
+                b->next = head;
+            } while (!_buffers.compare_exchange_weak(head, b, std::memory_order_release,
+                    std::memory_order_relaxed));
+            return b;
+        }
+    };
+
+    //Trace policies. null_trace drops everything at compile time,
+    //ring_trace records into the thread's buffer of the global registry.
+    class null_trace {
+    public:
+        static const bool enabled = false;
+        static void record(trace_op, uint64_t, uint64_t, uint64_t, unsigned = 1) {}
+    };
+    class ring_trace {
+    public:
+        static const bool enabled = true;
+        static void record(trace_op op, uint64_t start, uint64_t ticks, uint64_t detail, unsigned weight = 1) {
+            trace_registry::global().local().record(op, start, ticks, detail, weight);
+        }
+    };
+
+    //Times its own lifetime as one op event carrying detail, e.g. bytes
+    //moved, counted weight times in the histogram. With weight 0 nothing is
+    //recorded, see _trace_wanted.
+    template<class Policy>
+    class trace_scope {
+    public:
+        trace_scope(trace_op op, uint64_t detail, unsigned weight = 1):
+            _op(op), _weight(weight), _detail(detail), _start(weight ? _read_tsc() : 0) {}
+        ~trace_scope() {
+            if (0 != _start)
+                Policy::record(_op, _start, _read_tsc() - _start, _detail, _weight);
+        }
+    private:
+        trace_op _op;
+        unsigned _weight;
+        uint64_t _detail;
+        uint64_t _start;
+
+        trace_scope(const trace_scope&);
+        trace_scope& operator=(const trace_scope&);
+    };
+    template<>
+    class trace_scope<null_trace> {
+    public:
+        trace_scope(trace_op, uint64_t, unsigned = 1) {}
+    };
+
+    //Policy of the container hooks, chosen when building.
+#if defined(MYSTL_TRACE)
+    typedef ring_trace trace_policy;
+#else
+    typedef null_trace trace_policy;
+#endif
+
+    //Two clock reads cost tens of nanoseconds, as much as a small
+    //allocation. Ops moving trace_min_bytes or more are always timed, smaller
+    //ones 1 in trace_sample_rate. A sample stands for trace_sample_rate ops,
+    //so both populations keep their true share of one histogram.
+    const size_t trace_min_bytes = (size_t)64 << 10;
+    const unsigned trace_sample_rate = 256;
+
+    inline bool _trace_sample() {
+        static thread_local unsigned n = 0;
+        return ++n % trace_sample_rate == 0;
+    }
+    //Histogram weight of an op moving bytes, 0 if it is not timed. Folds to
+    //0 under null_trace.
+    template<class Policy>
+    unsigned _trace_wanted(size_t bytes) {
+        if (!Policy::enabled)
+            return 0;
+        if (bytes >= trace_min_bytes)
+            return 1;
+        return _trace_sample() ? trace_sample_rate : 0;
+    }
+    //Only large ops are timed, small ones are not counted at all.
+    template<class Policy>
+    unsigned _trace_wanted_large(size_t bytes) {
+        return Policy::enabled && bytes >= trace_min_bytes ? 1 : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef MY_TYPE_TRAITS_H
+#define MY_TYPE_TRAITS_H
+
+#include <type_traits>
+
+namespace mystl {
+
+    //Compile time constants used for tag dispatch.
+    template<class T, T v>
+    class integral_constant {
+    public:
+        static const T value = v;
+        typedef T value_type;
+        typedef integral_constant type;
+    };
+    typedef integral_constant<bool, true> true_type;
+    typedef integral_constant<bool, false> false_type;
+
+    template<class T, class U>
+    class is_same: public false_type {};
+    template<class T>
+    class is_same<T, T>: public true_type {};
+
+    template<class T>
+    class remove_const {
+    public:
+        typedef T type;
+    };
+    template<class T>
+    class remove_const<const T> {
+    public:
+        typedef T type;
+    };
+
+    template<class T>
+    class is_pointer: public false_type {};
+    template<class T>
+    class is_pointer<T*>: public true_type {};
+
+    template<class T>
+    class remove_reference {
+    public:
+        typedef T type;
+    };
+    template<class T>
+    class remove_reference<T&> {
+    public:
+        typedef T type;
+    };
+    template<class T>
+    class remove_reference<T&&> {
+    public:
+        typedef T type;
+    };
+
+    //Cast to rvalue so the object can be moved from.
+    template<class T>
+    typename remove_reference<T>::type&& move(T&& t) {
+        return static_cast<typename remove_reference<T>::type&&>(t);
+    }
+    //Keep the value category of a forwarding reference.
+    template<class T>
+    T&& forward(typename remove_reference<T>::type& t) {
+        return static_cast<T&&>(t);
+    }
+    template<class T>
+    T&& forward(typename remove_reference<T>::type&& t) {
+        return static_cast<T&&>(t);
+    }
+
+    //Maps any valid type to void, for detecting members.
+    template<class T>
+    class _void_type {
+    public:
+        typedef void type;
+    };
+
+    template<bool B, class T = void>
+    class enable_if {};
+    template<class T>
+    class enable_if<true, T> {
+    public:
+        typedef T type;
+    };
+
+    template<bool B, class T, class F>
+    class conditional {
+    public:
+        typedef T type;
+    };
+    template<class T, class F>
+    class conditional<false, T, F> {
+    public:
+        typedef F type;
+    };
+
+    //Properties the compiler knows best.
+    template<class T>
+    class is_integral: public integral_constant<bool, std::is_integral<T>::value> {};
+    template<class T>
+    class is_scalar: public integral_constant<bool, std::is_scalar<T>::value> {};
+    template<class T>
+    class is_empty: public integral_constant<bool, std::is_empty<T>::value> {};
+    template<class T>
+    class is_trivially_copyable: public integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+    template<class T>
+    class is_default_constructible: public integral_constant<bool, std::is_default_constructible<T>::value> {};
+    template<class T>
+    class is_copy_constructible: public integral_constant<bool, std::is_copy_constructible<T>::value> {};
+    template<class T>
+    class is_nothrow_move_constructible: public integral_constant<bool, std::is_nothrow_move_constructible<T>::value> {};
+    template<class Base, class Derived>
+    class is_base_of: public integral_constant<bool, std::is_base_of<Base, Derived>::value> {};
+
+    //Value of type T for unevaluated expressions like decltype, never defined.
+    template<class T>
+    T&& declval();
+}
+
+#endif
@@ -1,20 +1,101 @@
 #ifndef MY_UNINITIALIZED_H
 #define MY_UNINITIALIZED_H
 
+#include <string.h>
 #include "my_iterator.h"
+#include "my_algobase.h"
 
 namespace mystl {
-    
+
     //Copy construct object between input iterator to result.
     template<class InputIterator, class ForwardIterator>
-    ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
-            ForwardIterator result) {
+    ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last,
+            ForwardIterator result, _loop_copy_tag) {
         for ( ; first != last; ++first) {
             new(&*result) typename iterator_traits<ForwardIterator>::value_type(*first);
             ++result;
         }
         return result;
     }
+    //Trivially copyable objects are constructed by copying their bytes.
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last,
+            ForwardIterator result, _bulk_copy_tag) {
+        return _copy(first, last, result, _bulk_copy_tag());
+    }
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last,
+            ForwardIterator result, _reverse_bulk_copy_tag) {
+        return _copy(first, last, result, _reverse_bulk_copy_tag());
+    }
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
+            ForwardIterator result) {
+        return _uninitialized_copy(first, last, result,
+                typename _copy_category<InputIterator, ForwardIterator>::type());
+    }
+    //Move construct objects between input iterator to result. If one throws,
+    //the ones already constructed are destroyed.
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_move(InputIterator first, InputIterator last,
+            ForwardIterator result, false_type) {
+        ForwardIterator cur = result;
+        try {
+            for ( ; first != last; ++first, ++cur)
+                new(&*cur) typename iterator_traits<ForwardIterator>::value_type(mystl::move(*first));
+        } catch (...) {
+            for ( ; result != cur; ++result)
+                _destroy(&*result);
+            throw;
+        }
+        return cur;
+    }
+    //Trivially copyable objects are moved by copying their bytes.
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_move(InputIterator first, InputIterator last,
+            ForwardIterator result, true_type) {
+        return uninitialized_copy(first, last, result);
+    }
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator uninitialized_move(InputIterator first, InputIterator last,
+            ForwardIterator result) {
+        return _uninitialized_move(first, last, result,
+                typename is_trivially_copyable<typename iterator_traits<InputIterator>::value_type>::type());
+    }
+
+    //Construct objects between input iterator to result for a reallocation,
+    //moved with true_type and copied with false_type. If one throws, the
+    //ones already constructed are destroyed.
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_relocate(InputIterator first, InputIterator last,
+            ForwardIterator result, true_type) {
+        return uninitialized_move(first, last, result);
+    }
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_relocate(InputIterator first, InputIterator last,
+            ForwardIterator result, false_type) {
+        ForwardIterator cur = result;
+        try {
+            for ( ; first != last; ++first, ++cur)
+                new(&*cur) typename iterator_traits<ForwardIterator>::value_type(*first);
+        } catch (...) {
+            for ( ; result != cur; ++result)
+                _destroy(&*result);
+            throw;
+        }
+        return cur;
+    }
+    //A reallocation moves T when that can not throw, so a failure never
+    //leaves the source half moved, or when T can not be copied at all.
+    template<class T>
+    class _relocate_by_move: public integral_constant<bool,
+            is_nothrow_move_constructible<T>::value || !is_copy_constructible<T>::value> {};
+    template<class InputIterator, class ForwardIterator>
+    ForwardIterator uninitialized_relocate(InputIterator first, InputIterator last,
+            ForwardIterator result) {
+        return _uninitialized_relocate(first, last, result,
+                typename _relocate_by_move<typename iterator_traits<InputIterator>::value_type>::type());
+    }
     //Fill allocated space between two iterator with value,
     template<class ForwardIterator, class T>
     void uninitialized_fill(ForwardIterator first, ForwardIterator last,
@@ -25,12 +106,30 @@ namespace mystl {
     }
     //Fill allocated space with n values.
     template<class ForwardIterator, class Size, class T>
-    void uninitialized_fill_n(ForwardIterator first, Size n, const T& value) {
+    void _uninitialized_fill_n(ForwardIterator first, Size n, const T& value, false_type) {
         for ( ; n > 0; --n) {
             new(&*first) typename iterator_traits<ForwardIterator>::value_type(value);
             first++;
         }
     }
+    template<class ForwardIterator, class Size, class T>
+    void _uninitialized_fill_n(ForwardIterator first, Size n, const T& value, true_type) {
+        _fill_n(first, n, value, true_type());
+    }
+    template<class ForwardIterator, class Size, class T>
+    void uninitialized_fill_n(ForwardIterator first, Size n, const T& value) {
+        _uninitialized_fill_n(first, n, value, typename _is_byte_fillable<ForwardIterator>::type());
+    }
+    //Default-initialize n objects in allocated space.
+    //Trivial types are left as they are, so this costs no pass over memory.
+    template<class ForwardIterator, class Size>
+    ForwardIterator uninitialized_default_init_n(ForwardIterator first, Size n) {
+        for ( ; n > 0; --n) {
+            _default_construct(addressof(*first));
+            ++first;
+        }
+        return first;
+    }
 }
 
 #endif
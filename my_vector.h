@@ -5,9 +5,20 @@
 #include "my_memory"
 #include "my_algobase.h"
 #include "my_iterator.h"
+#include "my_parallel.h"
+#include "my_trace.h"
 
 namespace mystl {
 
+    //Growth policy of vector, shared with containers laid out like it:
+    //double the capacity, starting from 1, until required elements fit.
+    inline size_t _grown_capacity(size_t capacity, size_t required) {
+        size_t n = capacity ? capacity : 1;
+        while (n < required)
+            n <<= 1;
+        return n;
+    }
+
     template<typename T, typename Alloc = allocator<T> >
     class vector {
     public:
@@ -31,35 +42,108 @@ namespace mystl {
         explicit vector(size_type n, const_reference _value = value_type(), 
                 const allocator_type& alloc = allocator_type()):
             _size(n), _capacity(n), _allocator(alloc) {
-            _first = _allocator.allocate(n);
+            _first = n ? _allocator.allocate(n) : 0;
             uninitialized_fill_n(_first, n, _value);
         }
+        //Construct n default-initialized elements, trivial types stay unwritten.
+        vector(size_type n, default_init_t, const allocator_type& alloc = allocator_type()):
+            _size(n), _capacity(n), _allocator(alloc) {
+            _first = n ? _allocator.allocate(n) : 0;
+            uninitialized_default_init_n(_first, n);
+        }
+        //Construct n elements with value on several threads, see parallel_policy.
+        vector(size_type n, const_reference _value, const parallel_policy& policy,
+                const allocator_type& alloc = allocator_type()):
+            _size(0), _capacity(n), _allocator(alloc) {
+            _first = n ? _allocator.allocate(n) : 0;
+            try {
+                parallel_uninitialized_fill_n(_first, n, _value, policy);
+            } catch (...) {
+                if (0 != _first)
+                    _allocator.deallocate(_first, n);
+                throw;
+            }
+            _size = n;
+        }
         //Range constructor. Construct elements as a copy between two iterator.
+        //Integral arguments, as in vector(3, 7), mean n copies of a value.
         template<typename inputIterator>
-        explicit vector(inputIterator first, inputIterator last,
-                const allocator_type& alloc = allocator_type()): _allocator(alloc)  {
-            _size = last - first;
-            _capacity = _size;
-            _first = _allocator.allocate(_size);
-			uninitialized_copy(first, last, _first);
+        vector(inputIterator first, inputIterator last,
+                const allocator_type& alloc = allocator_type()):
+            _size(0), _capacity(0), _first(0), _allocator(alloc) {
+            initialize_dispatch(first, last, typename is_integral<inputIterator>::type());
 		}
-        //Copy constructor.
-        vector(const vector& v): _size(v._size), _capacity(v._capacity) {
-            _first = _allocator.allocate(_capacity);
+        //Range constructor copying on several threads. The range is walked
+        //twice, so it must be a forward range.
+        template<typename ForwardIterator>
+        vector(ForwardIterator first, ForwardIterator last, const parallel_policy& policy,
+                const allocator_type& alloc = allocator_type(),
+                typename enable_if<!is_integral<ForwardIterator>::value>::type* = 0):
+            _size(0), _allocator(alloc) {
+            _capacity = distance(first, last);
+            _first = _capacity ? _allocator.allocate(_capacity) : 0;
+            try {
+                parallel_uninitialized_copy(first, last, _first, policy);
+            } catch (...) {
+                if (0 != _first)
+                    _allocator.deallocate(_first, _capacity);
+                throw;
+            }
+            _size = _capacity;
+        }
+        //Copy constructor. An empty vector owns no buffer, release() relies on it.
+        vector(const vector& v): _size(v._size), _capacity(v._capacity), _allocator(v._allocator) {
+            _first = _capacity ? _allocator.allocate(_capacity) : 0;
 			uninitialized_copy(v.begin(), v.end(), _first);
         }
+        //Move constructor, takes over the buffer of v in O(1).
+        vector(vector&& v): _size(v._size), _capacity(v._capacity), _first(v._first),
+            _allocator(v._allocator) {
+            v._size = 0;
+            v._capacity = 0;
+            v._first = 0;
+        }
         //Destructor.
         ~vector() {
-			for (size_type i = 0; i < _size; ++i)
-				_allocator.destroy(addressof(*(_first + i)));
-            if (0 != _capacity)
-                _allocator.deallocate(addressof(*_first), _capacity);
+            release();
         }
 
         vector& operator=(const vector& v) {
+            typedef allocator_traits<allocator_type> traits;
+            if (this == &v)
+                return *this;
+            //An allocator that propagates on copy must own the memory we fill.
+            if (traits::propagate_on_container_copy_assignment::value
+                    && !traits::equal(_allocator, v._allocator)) {
+                release();
+                _allocator = v._allocator;
+            }
 			assign(v.begin(), v.end());
 			return *this;
 		}
+        //Move assignment takes over the buffer of v in O(1) whenever this
+        //allocator can free it, otherwise it falls back to copying elements.
+        vector& operator=(vector&& v) {
+            typedef allocator_traits<allocator_type> traits;
+            if (this == &v)
+                return *this;
+            if (traits::propagate_on_container_move_assignment::value
+                    || traits::equal(_allocator, v._allocator)) {
+                release();
+                traits::propagate(_allocator, v._allocator,
+                        typename traits::propagate_on_container_move_assignment());
+                _first = v._first;
+                _size = v._size;
+                _capacity = v._capacity;
+                v._first = 0;
+                v._size = 0;
+                v._capacity = 0;
+            } else {
+                assign(v.begin(), v.end());
+                v.clear();
+            }
+            return *this;
+        }
         
         
         //Functions about data access.
@@ -82,14 +166,14 @@ namespace mystl {
             return reverse_iterator(_first + _size);
         }
 		const_reverse_iterator rbegin() const {
-			return rbegin();
+			return const_reverse_iterator(_first + _size);
 		}
         //Get last reverse iterator.
         reverse_iterator rend() {
             return reverse_iterator(_first);
         }
 		const_reverse_iterator rend() const {
-			return rend();
+			return const_reverse_iterator(_first);
 		}
         
         //Get size.
@@ -107,7 +191,7 @@ namespace mystl {
         //Resize vector.
         void resize(size_type n, const value_type& value = value_type()) {    
             if (n <= _size) {
-				for (iterator i = _first + n; i < end() - n; ++i)
+				for (iterator i = _first + n; i < end(); ++i)
 					_allocator.destroy(addressof(*(i)));
             } else if (n <= _capacity) {
 				uninitialized_fill_n(_first + _size, n - _size, value);
@@ -117,6 +201,56 @@ namespace mystl {
             }
             _size = n;
         }
+        //Resize vector, growing on several threads. A new buffer is filled by
+        //the same threads that build the new elements.
+        void resize(size_type n, const value_type& value, const parallel_policy& policy) {
+            if (n <= _size) {
+                resize(n, value);
+                return;
+            }
+            if (n > _capacity)
+                extend_space(n, policy);
+            parallel_uninitialized_fill_n(_first + _size, n - _size, value, policy);
+            _size = n;
+        }
+        //Resize vector, new elements are default-initialized.
+        //Meant for buffers that are overwritten right after, e.g. by read().
+        void resize_default_init(size_type n) {
+            if (n <= _size) {
+                for (iterator i = _first + n; i < end(); ++i)
+                    _allocator.destroy(addressof(*(i)));
+            } else {
+                if (n > _capacity)
+                    auto_extend_space(n);
+                uninitialized_default_init_n(_first + _size, n - _size);
+            }
+            _size = n;
+        }
+        //Make room for n more elements and return a pointer to the raw space.
+        //The caller constructs elements there, then calls commit_append.
+        pointer append_uninitialized(size_type n) {
+            if (_size + n > _capacity)
+                auto_extend_space(_size + n);
+            return _first + _size;
+        }
+        //Take n elements constructed after append_uninitialized into the vector.
+        void commit_append(size_type n) {
+            _size += n;
+        }
+        //Replace contents with n elements copied from raw memory.
+        //Old elements are dropped before growing, so they are never relocated,
+        //and p must not point into this vector.
+        void assign_from_raw(const_pointer p, size_type n) {
+            clear();
+            if (n > _capacity) {
+                if (0 != _capacity)
+                    _allocator.deallocate(_first, _capacity);
+                _first = _allocator.allocate(n);
+                _capacity = n;
+            }
+            uninitialized_copy(p, p + n, _first);
+            _size = n;
+        }
         //Check if the vector is empty.
         bool empty() const {
             return _size == 0;
@@ -126,7 +260,7 @@ namespace mystl {
             return *(_first + n);
         }
         const_reference operator[](size_t n) const {
-            return operator[](n);
+            return *(_first + n);
         }
         //Access element.
         reference at(size_t n) {
@@ -137,21 +271,23 @@ namespace mystl {
             }
         }
         const_reference at(size_t n) const {
-            return at(n);
+            if (n >= _size)
+                throw std::out_of_range("my_vector access out of range");
+            return *(_first + n);
         }
         //Get front
         reference front() {
             return *(_first);
         }
         const_reference front() const {
-            return front();
+            return *(_first);
         }
         //Get back
         reference back() {
             return *(_first + _size - 1);
         }
         const_reference back() const {
-            return back();
+            return *(_first + _size - 1);
         }
         //Get allocator.
         allocator_type& get_allocator() {
@@ -160,23 +296,44 @@ namespace mystl {
         
         //Operations on vector.
         //Assign values.
+        //Integral arguments mean n copies of a value, like the constructor.
         template<typename inputIterator>
         void assign(inputIterator first, inputIterator last) {
-			size_type n = last - first;
-			if (_capacity < n) {
-				auto_extend_space(n);
-			}
-			if (_size <= n) {
-				copy(first, first + _size, _first);
-				uninitialized_copy(first + _size, last, _first + _size);
-			} else {
-				copy(first, last, _first);
-				for (size_type i = n; i < _size; ++i)
-					_allocator.destroy(addresso(*(_first + i)));
-			}
-			_size = n;
-
+            assign_dispatch(first, last, typename is_integral<inputIterator>::type());
 		}
+        void assign(size_type n, const value_type& value) {
+            if (n > _capacity) {
+                vector temp(n, value, _allocator);
+                swap(temp);
+            } else if (n > _size) {
+                fill(_first, _first + _size, value);
+                uninitialized_fill_n(_first + _size, n - _size, value);
+                _size = n;
+            } else {
+                fill_n(_first, n, value);
+                destroy_tail(n);
+            }
+        }
+        //Assign values on several threads. Old elements are dropped first and
+        //a bigger buffer is taken fresh, so every page is first written by a
+        //worker, and the range must not point into this vector. If a copy
+        //throws the vector is left empty.
+        template<typename ForwardIterator>
+        void assign(ForwardIterator first, ForwardIterator last, const parallel_policy& policy,
+                typename enable_if<!is_integral<ForwardIterator>::value>::type* = 0) {
+            size_type n = distance(first, last);
+            clear();
+            if (n > _capacity) {
+                if (0 != _capacity)
+                    _allocator.deallocate(_first, _capacity);
+                _first = 0;
+                _capacity = 0;
+                _first = _allocator.allocate(n);
+                _capacity = n;
+            }
+            parallel_uninitialized_copy(first, last, _first, policy);
+            _size = n;
+        }
         //Push element to back.
         void push_back(const value_type& value) {
             if (_size == _capacity) {
@@ -185,6 +342,13 @@ namespace mystl {
             _allocator.construct(addressof(*((_first + _size))), value);
             ++_size;
         }
+        void push_back(value_type&& value) {
+            if (_size == _capacity) {
+                auto_extend_space(_capacity + 1);
+            }
+            new(addressof(*(_first + _size))) value_type(mystl::move(value));
+            ++_size;
+        }
         //Pop last element.
         void pop_back() {
             if (!empty()) {
@@ -195,56 +359,26 @@ namespace mystl {
         //Insert element at position
         iterator insert(iterator position, const value_type& value) {
             size_type pos = position - _first;
-            if (_size == _capacity) {
-                auto_extend_space(_capacity + 1);
-            }
-            position = _first + pos;
-			if (!empty()) {
-				_allocator.construct(addressof(*(_first + _size)), *(_first + _size - 1));
-				copy_backwd(position, _first + _size - 1, position + 1);
-			}
-            *position = value;
-            ++_size;
-            return position;
+            fill_insert(position, 1, value);
+            return _first + pos;
         }
         //Fill insert.
         void insert(iterator position, size_type n, const value_type& value) {
-            size_type pos = position - _first;
-            if (_size + n > _capacity) {
-                auto_extend_space(_size + n);
-            }
-            position = _first + pos;
-			if (_size >= n) {
-				uninitialized_copy(_first + _size - n, _first + _size, _first + _size);
-			copy_backwd(position, _first + _size - n, position + n);
-            fill_n(position, n, value);
-			} else {
-				uninitialized_copy(position, end(), position + n);
-				fill(position, end(), value);
-				uninitialized_fill(end(), position + n, value);
-			}
-			_size += n;
+            fill_insert(position, n, value);
         }
-        //Range insert.
-        void insert(iterator position, iterator first, iterator last) {
-            size_type n = last - first;
-            size_type pos = position - _first;
-            if (_size + n > _capacity)
-                auto_extend_space(_size + n);
-            position = _first + pos;
-			if (_size >= n) {
-				uninitialized_copy(_first + _size - n, _first + _size, _first + _size);
-			copy_backwd(position, _first + _size - n, position + n);
-			copy(first, last, position);
-			} else {
-				uninitialized_copy(position, end(), position + n);
-				copy(first, first + (end() - position), position);
-				uninitialized_copy(first + (end() - position), last, end());
-			}
-			_size += n;
+        //Range insert, return the position of the first inserted element.
+        //Forward ranges are measured once, then either shifted into place in
+        //spare capacity or copied with the rest into one new buffer.
+        //Input ranges are appended and rotated into place.
+        //The range must not point into this vector.
+        template<typename inputIterator>
+        iterator insert(iterator position, inputIterator first, inputIterator last) {
+            return insert_dispatch(position, first, last, typename is_integral<inputIterator>::type());
         }
         //Erase element at position.
         iterator erase(iterator position) {
+            trace_scope<trace_policy> trace(trace_erase_shift, (end() - position) * sizeof(value_type),
+                    _trace_wanted_large<trace_policy>((end() - position) * sizeof(value_type)));
 			if (position != end())
                 copy(position + 1, end(), position);
 			(end() - 1)->~value_type();
@@ -255,14 +389,26 @@ namespace mystl {
             size_type n = last - first;
             if (n <= 0)
                 return first;
+            trace_scope<trace_policy> trace(trace_erase_shift, (end() - last) * sizeof(value_type),
+                    _trace_wanted_large<trace_policy>((end() - last) * sizeof(value_type)));
             copy(last, end(), first);
 			for (size_type i = n ; i > 0; --i)
-				_allocator.destroy(addressof(*(end() - n)));
+				_allocator.destroy(addressof(*(end() - i)));
             _size -= n;
             return first;
         }
         //Swap contents of two vector.
+        //Buffers are exchanged in O(1) when the allocators propagate on swap or
+        //compare equal. Only unequal, non-propagating allocators swap element by element.
         void swap(vector& x) {
+            typedef allocator_traits<allocator_type> traits;
+            if (traits::propagate_on_container_swap::value || traits::equal(_allocator, x._allocator)) {
+                mystl::swap(_first, x._first);
+                mystl::swap(_size, x._size);
+                mystl::swap(_capacity, x._capacity);
+                traits::swap(_allocator, x._allocator, typename traits::propagate_on_container_swap());
+                return;
+            }
 			if (_capacity < x.size())
 				auto_extend_space(x.size());
 			if (x.capacity() < _size)
@@ -284,7 +430,8 @@ namespace mystl {
 		}
 		//Resize capacity.
 		void reserve(size_type n) {
-			extend_space(n);
+			if (n > _capacity)
+				extend_space(n);
 		}
         //Clear vector.
         void clear() {
@@ -300,20 +447,221 @@ namespace mystl {
         pointer _first;
         allocator_type _allocator;
 
+        //Destroy elements and free the buffer.
+        void release() {
+			for (size_type i = 0; i < _size; ++i)
+				_allocator.destroy(addressof(*(_first + i)));
+            if (0 != _capacity)
+                _allocator.deallocate(addressof(*_first), _capacity);
+            _size = 0;
+            _capacity = 0;
+            _first = 0;
+        }
+        //Destroy elements from n on.
+        void destroy_tail(size_type n) {
+            for (size_type i = n; i < _size; ++i)
+                _allocator.destroy(addressof(*(_first + i)));
+            _size = n;
+        }
+        //Constructor, assign and insert dispatch: integral arguments fill,
+        //forward ranges are measured once, input ranges are read once.
+        template<typename Integer>
+        void initialize_dispatch(Integer n, Integer value, true_type) {
+            _first = n ? _allocator.allocate((size_type)n) : 0;
+            _capacity = (size_type)n;
+            uninitialized_fill_n(_first, (size_type)n, (value_type)value);
+            _size = (size_type)n;
+        }
+        template<typename inputIterator>
+        void initialize_dispatch(inputIterator first, inputIterator last, false_type) {
+            range_initialize(first, last, typename iterator_traits<inputIterator>::iterator_category());
+        }
+        template<typename inputIterator>
+        void range_initialize(inputIterator first, inputIterator last, input_iterator_tag) {
+            for ( ; first != last; ++first)
+                push_back(*first);
+        }
+        template<typename ForwardIterator>
+        void range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            size_type n = distance(first, last);
+            _first = n ? _allocator.allocate(n) : 0;
+            _capacity = n;
+            uninitialized_copy(first, last, _first);
+            _size = n;
+        }
+        template<typename Integer>
+        void assign_dispatch(Integer n, Integer value, true_type) {
+            assign((size_type)n, (value_type)value);
+        }
+        template<typename inputIterator>
+        void assign_dispatch(inputIterator first, inputIterator last, false_type) {
+            range_assign(first, last, typename iterator_traits<inputIterator>::iterator_category());
+        }
+        template<typename inputIterator>
+        void range_assign(inputIterator first, inputIterator last, input_iterator_tag) {
+            size_type i = 0;
+            for ( ; first != last && i < _size; ++first, ++i)
+                *(_first + i) = *first;
+            if (first == last) {
+                destroy_tail(i);
+            } else {
+                for ( ; first != last; ++first)
+                    push_back(*first);
+            }
+        }
+        //A bigger range goes to a fresh buffer, old elements are never relocated.
+        template<typename ForwardIterator>
+        void range_assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            size_type n = distance(first, last);
+            if (n > _capacity) {
+                vector temp(_allocator);
+                temp._first = _allocator.allocate(n);
+                temp._capacity = n;
+                uninitialized_copy(first, last, temp._first);
+                temp._size = n;
+                swap(temp);
+            } else if (n > _size) {
+                ForwardIterator mid = first;
+                advance(mid, _size);
+                copy(first, mid, _first);
+                uninitialized_copy(mid, last, _first + _size);
+                _size = n;
+            } else {
+                copy(first, last, _first);
+                destroy_tail(n);
+            }
+        }
+        template<typename Integer>
+        iterator insert_dispatch(iterator position, Integer n, Integer value, true_type) {
+            size_type pos = position - _first;
+            fill_insert(position, (size_type)n, (value_type)value);
+            return _first + pos;
+        }
+        template<typename inputIterator>
+        iterator insert_dispatch(iterator position, inputIterator first, inputIterator last, false_type) {
+            return range_insert(position, first, last,
+                    typename iterator_traits<inputIterator>::iterator_category());
+        }
+        template<typename inputIterator>
+        iterator range_insert(iterator position, inputIterator first, inputIterator last, input_iterator_tag) {
+            size_type pos = position - _first;
+            size_type old = _size;
+            for ( ; first != last; ++first)
+                push_back(*first);
+            rotate(_first + pos, _first + old, _first + _size);
+            return _first + pos;
+        }
+        template<typename ForwardIterator>
+        iterator range_insert(iterator position, ForwardIterator first, ForwardIterator last,
+                forward_iterator_tag) {
+            size_type n = distance(first, last);
+            size_type pos = position - _first;
+            if (n == 0)
+                return position;
+            if (_capacity - _size >= n) {
+                pointer old_end = _first + _size;
+                size_type after = _size - pos;
+                if (after > n) {
+                    uninitialized_copy(old_end - n, old_end, old_end);
+                    _size += n;
+                    copy_backwd(position, old_end - n, old_end);
+                    copy(first, last, position);
+                } else {
+                    ForwardIterator mid = first;
+                    advance(mid, after);
+                    uninitialized_copy(mid, last, old_end);
+                    uninitialized_copy(position, old_end, old_end + (n - after));
+                    _size += n;
+                    copy(first, mid, position);
+                }
+            } else {
+                size_type cap = grown_capacity(_size + n);
+                trace_scope<trace_policy> trace(trace_reallocate, cap * sizeof(value_type),
+                        _trace_wanted<trace_policy>(cap * sizeof(value_type)));
+                pointer temp = _allocator.allocate(cap);
+                pointer cur = temp;
+                try {
+                    cur = uninitialized_copy(_first, position, cur);
+                    cur = uninitialized_copy(first, last, cur);
+                    cur = uninitialized_copy(position, _first + _size, cur);
+                } catch (...) {
+                    for (pointer p = temp; p != cur; ++p)
+                        _allocator.destroy(p);
+                    _allocator.deallocate(temp, cap);
+                    throw;
+                }
+                size_type size = _size + n;
+                release();
+                _first = temp;
+                _capacity = cap;
+                _size = size;
+            }
+            return _first + pos;
+        }
+        void fill_insert(iterator position, size_type n, const value_type& v) {
+            if (n == 0)
+                return;
+            //v may be an element of this vector.
+            value_type value(v);
+            if (_capacity - _size >= n) {
+                pointer old_end = _first + _size;
+                size_type after = old_end - position;
+                if (after > n) {
+                    uninitialized_copy(old_end - n, old_end, old_end);
+                    _size += n;
+                    copy_backwd(position, old_end - n, old_end);
+                    fill_n(position, n, value);
+                } else {
+                    uninitialized_fill_n(old_end, n - after, value);
+                    uninitialized_copy(position, old_end, position + n);
+                    _size += n;
+                    fill(position, old_end, value);
+                }
+            } else {
+                size_type cap = grown_capacity(_size + n);
+                trace_scope<trace_policy> trace(trace_reallocate, cap * sizeof(value_type),
+                        _trace_wanted<trace_policy>(cap * sizeof(value_type)));
+                pointer temp = _allocator.allocate(cap);
+                pointer cur = temp;
+                try {
+                    cur = uninitialized_copy(_first, position, cur);
+                    uninitialized_fill_n(cur, n, value);
+                    cur += n;
+                    cur = uninitialized_copy(position, _first + _size, cur);
+                } catch (...) {
+                    for (pointer p = temp; p != cur; ++p)
+                        _allocator.destroy(p);
+                    _allocator.deallocate(temp, cap);
+                    throw;
+                }
+                size_type size = _size + n;
+                release();
+                _first = temp;
+                _capacity = cap;
+                _size = size;
+            }
+        }
+        //Capacity to grow to for required elements.
+        size_type grown_capacity(size_type required) const {
+            return _grown_capacity(_capacity, required);
+        }
         //Handle element number overflow.
         void auto_extend_space(size_type required) {
-            size_type new_size = _capacity;
-            if (0 == _capacity)
-                new_size = 1;
-            while (new_size < required)
-                new_size = new_size << 1;
-			extend_space(new_size);
+			extend_space(grown_capacity(required));
 		}
-		//Extend space.
+		//Extend space. Elements are moved when that can not throw, copied
+		//otherwise; if that throws the vector is left as it was.
 		void extend_space(size_type n) {
+			trace_scope<trace_policy> trace(trace_reallocate, n * sizeof(value_type),
+					_trace_wanted<trace_policy>(n * sizeof(value_type)));
 			iterator temp(_allocator.allocate(n));
 			if (0 != _capacity) {
-				copy(_first, end(), temp);
+				try {
+					uninitialized_relocate(_first, end(), temp);
+				} catch (...) {
+					_allocator.deallocate(temp, n);
+					throw;
+				}
 				for (size_type i = 0; i < _size; ++i)
 					_allocator.destroy(_first + i);
                 _allocator.deallocate(_first, _capacity);
@@ -322,6 +670,25 @@ namespace mystl {
             _capacity = n;
 
 		}
+		//Extend space, relocating elements on several threads.
+		void extend_space(size_type n, const parallel_policy& policy) {
+			trace_scope<trace_policy> trace(trace_reallocate, n * sizeof(value_type),
+					_trace_wanted<trace_policy>(n * sizeof(value_type)));
+			pointer temp = _allocator.allocate(n);
+			try {
+				parallel_uninitialized_copy(_first, _first + _size, temp, policy);
+			} catch (...) {
+				_allocator.deallocate(temp, n);
+				throw;
+			}
+			if (0 != _capacity) {
+				for (size_type i = 0; i < _size; ++i)
+					_allocator.destroy(_first + i);
+				_allocator.deallocate(_first, _capacity);
+			}
+			_first = temp;
+			_capacity = n;
+		}
         
     };
 
@@ -0,0 +1,69 @@
+//Copy-on-write checks for cow_vector, mainly iterators taken before a copy.
+//Build: g++ -std=c++11 -I.. cow_vector_test.cpp && ./a.out
+#include <assert.h>
+#include <stdio.h>
+#include "../my_cow_vector.h"
+
+using mystl::cow_vector;
+
+static cow_vector<int> make(int n) {
+    cow_vector<int> v;
+    for (int i = 0; i < n; ++i)
+        v.push_back(i);
+    return v;
+}
+
+static void test_share_and_detach() {
+    cow_vector<int> a = make(4);
+    cow_vector<int> b(a);
+    const cow_vector<int>& ca = a;
+    const cow_vector<int>& cb = b;
+    assert(a.use_count() == 2 && ca.data() == cb.data());
+    b[0] = 7;
+    assert(ca.data() != cb.data() && ca[0] == 0 && cb[0] == 7);
+    assert(a.use_count() == 1 && b.use_count() == 1);
+}
+
+static void test_erase_after_copy() {
+    cow_vector<int> v = make(5);
+    cow_vector<int>::iterator it = v.begin() + 1;
+    cow_vector<int> w = v;
+    v.erase(it);
+    const cow_vector<int>& cv = v;
+    const cow_vector<int>& cw = w;
+    assert(cv.size() == 4 && cv[1] == 2);
+    assert(cw.size() == 5 && cw[1] == 1);
+
+    cow_vector<int>::iterator first = v.begin() + 1;
+    cow_vector<int>::iterator last = v.begin() + 3;
+    cow_vector<int> x = v;
+    v.erase(first, last);
+    assert(cv.size() == 2 && cv[0] == 0 && cv[1] == 4);
+    assert(x.size() == 4);
+}
+
+static void test_insert_after_copy() {
+    cow_vector<int> v = make(4);
+    cow_vector<int>::iterator it = v.begin() + 2;
+    cow_vector<int> w = v;
+    cow_vector<int>::iterator r = v.insert(it, 9);
+    const cow_vector<int>& cv = v;
+    const cow_vector<int>& cw = w;
+    assert(*r == 9 && cv.size() == 5 && cv[2] == 9 && cv[3] == 2);
+    assert(cw.size() == 4 && cw[2] == 2);
+
+    int more[] = {7, 8};
+    it = v.begin() + 1;
+    cow_vector<int> x = v;
+    v.insert(it, more, more + 2);
+    assert(cv.size() == 7 && cv[1] == 7 && cv[2] == 8 && cv[3] == 1);
+    assert(x.size() == 5);
+}
+
+int main() {
+    test_share_and_detach();
+    test_erase_after_copy();
+    test_insert_after_copy();
+    printf("cow_vector_test passed\n");
+    return 0;
+}